@@ -0,0 +1,172 @@
+#pragma once
+/*
+ * Minimal Arduino core emulation for the host-native (Linux) FX benchmark build.
+ * Only what the FX engine sources need to compile and run is provided; hardware access is stubbed.
+ * Time is virtual: millis()/micros() return a clock that is advanced by the benchmark runner (see nativeBenchAdvance()).
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+#include <ctype.h>
+#include <limits.h>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <atomic>
+
+#include "esp_idf_shim.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "pgmspace.h"
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "IPAddress.h"
+
+#ifndef __GLIBC_PREREQ
+#define __GLIBC_PREREQ(a, b) 0
+#endif
+#if !__GLIBC_PREREQ(2, 38)
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size) { size_t n = len < size - 1 ? len : size - 1; memcpy(dst, src, n); dst[n] = 0; }
+  return len;
+}
+inline size_t strlcat(char *dst, const char *src, size_t size) {
+  size_t dlen = strnlen(dst, size);
+  return dlen == size ? size + strlen(src) : dlen + strlcpy(dst + dlen, src, size - dlen);
+}
+#endif
+
+typedef uint8_t  byte;
+typedef bool     boolean;
+typedef uint16_t word;
+inline uint16_t makeWord(uint16_t w) { return w; }
+inline uint16_t makeWord(uint8_t h, uint8_t l) { return (h << 8) | l; }
+#define word(...) makeWord(__VA_ARGS__)
+
+#define LOW    0x0
+#define HIGH   0x1
+#define INPUT  0x01
+#define OUTPUT 0x03
+#define PULLUP 0x04
+#define INPUT_PULLUP   0x05
+#define PULLDOWN       0x08
+#define INPUT_PULLDOWN 0x09
+#define OPEN_DRAIN     0x10
+#define OUTPUT_OPEN_DRAIN 0x12
+#define ANALOG 0xC0
+#define CHANGE  0x03
+#define FALLING 0x02
+#define RISING  0x01
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+#ifndef M_TWOPI
+#define M_TWOPI 6.283185307179586476925286766559
+#endif
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+#define EULER 2.718281828459045235360287471352
+
+#define radians(deg) ((deg)*DEG_TO_RAD)
+#define degrees(rad) ((rad)*RAD_TO_DEG)
+#define sq(x) ((x)*(x))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define lowByte(w) ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#ifndef bit
+#define bit(b) (1UL << (b))
+#endif
+#define _min(a,b) ((a)<(b)?(a):(b))
+#define _max(a,b) ((a)>(b)?(a):(b))
+
+// same semantics as the ESP8266/ESP32 cores: mixed argument types are allowed
+template<class T, class L> inline auto min(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (b < a) ? b : a; }
+template<class T, class L> inline auto max(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (a < b) ? b : a; }
+using std::abs;
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  const long dividend = out_max - out_min;
+  const long divisor  = in_max - in_min;
+  if (divisor == 0) return -1; // AVR returns -1, SAM returns 0
+  return (x - in_min) * dividend / divisor + out_min;
+}
+
+// virtual time base (microseconds), advanced by the benchmark runner (atomic as the output task reads it too)
+extern std::atomic<uint64_t> nativeBenchMicros;
+inline unsigned long millis() { return (unsigned long)(nativeBenchMicros / 1000ULL); }
+inline unsigned long micros() { return (unsigned long)nativeBenchMicros; }
+inline void delay(uint32_t ms) { nativeBenchMicros += ms * 1000ULL; }
+inline void delayMicroseconds(uint32_t us) { nativeBenchMicros += us; }
+inline void yield() {}
+inline void nativeBenchAdvance(uint32_t us) { nativeBenchMicros += us; }
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int  digitalRead(uint8_t) { return LOW; }
+inline uint16_t analogRead(uint8_t) { return 0; }
+inline void analogWrite(uint8_t, int) {}
+inline void attachInterrupt(uint8_t, std::function<void(void)>, int) {}
+inline void detachInterrupt(uint8_t) {}
+inline uint8_t digitalPinToInterrupt(uint8_t p) { return p; }
+
+inline long random(long howbig) { return howbig ? ::rand() % howbig : 0; }
+inline long random(long howsmall, long howbig) { return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall); }
+inline void randomSeed(unsigned long seed) { ::srand(seed); }
+
+class HardwareSerial : public Stream {
+  public:
+    void begin(unsigned long, uint32_t = 0, int8_t = -1, int8_t = -1) {}
+    void end() {}
+    void flush() override {}
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    size_t write(uint8_t c) override { return fputc(c, stderr) == EOF ? 0 : 1; }
+    size_t write(const uint8_t *buffer, size_t size) override { return fwrite(buffer, 1, size, stderr); }
+    using Print::write;
+    int availableForWrite() override { return 128; }
+    operator bool() const { return true; }
+    void setDebugOutput(bool) {}
+    void setRxBufferSize(size_t) {}
+};
+extern HardwareSerial Serial;
+
+class EspClass {
+  public:
+    uint32_t getFreeHeap();
+    uint32_t getHeapSize();
+    uint32_t getMinFreeHeap() { return getFreeHeap(); }
+    uint32_t getMaxAllocHeap() { return getFreeHeap(); }
+    uint32_t getMaxFreeBlockSize() { return getFreeHeap(); }
+    uint32_t getPsramSize() { return 0; }
+    uint32_t getFreePsram() { return 0; }
+    uint32_t getMaxAllocPsram() { return 0; }
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getFlashChipSize() { return 4*1024*1024; }
+    uint32_t getSketchSize() { return 0; }
+    uint32_t getFreeSketchSpace() { return 0; }
+    uint8_t  getChipRevision() { return 3; }
+    uint8_t  getChipCores() { return 2; }
+    const char *getChipModel() { return "native"; }
+    const char *getSdkVersion() { return "native"; }
+    uint64_t getEfuseMac() { return 0x112233445566ULL; }
+    uint32_t getCycleCount() { return (uint32_t)(nativeBenchMicros * 240); }
+    void restart() { exit(0); }
+};
+extern EspClass ESP;
@@ -0,0 +1,26 @@
+#pragma once
+#include <Arduino.h>
+
+class AsyncClient {
+  public:
+    bool connect(IPAddress, uint16_t) { return false; }
+    bool connect(const char *, uint16_t) { return false; }
+    void close(bool = false) {}
+    bool connected() { return false; }
+    bool canSend() { return false; }
+    size_t space() { return 0; }
+    size_t add(const char *, size_t, uint8_t = 0) { return 0; }
+    size_t write(const char *) { return 0; }
+    size_t write(const char *, size_t, uint8_t = 0) { return 0; }
+    bool send() { return false; }
+    IPAddress remoteIP() { return IPAddress(); }
+    uint16_t remotePort() { return 0; }
+    void setNoDelay(bool) {}
+    void setRxTimeout(uint32_t) {}
+    void setAckTimeout(uint32_t) {}
+    void onConnect(std::function<void(void *, AsyncClient *)>, void * = nullptr) {}
+    void onDisconnect(std::function<void(void *, AsyncClient *)>, void * = nullptr) {}
+    void onData(std::function<void(void *, AsyncClient *, void *, size_t)>, void * = nullptr) {}
+    void onError(std::function<void(void *, AsyncClient *, int8_t)>, void * = nullptr) {}
+    void onTimeout(std::function<void(void *, AsyncClient *, uint32_t)>, void * = nullptr) {}
+};
@@ -0,0 +1,26 @@
+#pragma once
+#include <Arduino.h>
+#include <lwip/ip_addr.h>
+
+class AsyncUDPPacket {
+  public:
+    uint8_t *data() { return nullptr; }
+    size_t length() { return 0; }
+    IPAddress remoteIP() { return IPAddress(); }
+    uint16_t remotePort() { return 0; }
+    uint16_t localPort() { return 0; }
+    bool isBroadcast() { return false; }
+    bool isMulticast() { return false; }
+};
+typedef std::function<void(AsyncUDPPacket &packet)> AuPacketHandlerFunction;
+
+class AsyncUDP {
+  public:
+    bool listen(uint16_t) { return false; }
+    bool listen(const IPAddress &, uint16_t) { return false; }
+    bool listenMulticast(const IPAddress &, uint16_t, uint8_t = 1, int = 0) { return false; }
+    void onPacket(AuPacketHandlerFunction) {}
+    void close() {}
+    size_t writeTo(const uint8_t *, size_t, const IPAddress &, uint16_t, int = 0) { return 0; }
+    size_t broadcastTo(uint8_t *, size_t, uint16_t, int = 0) { return 0; }
+};
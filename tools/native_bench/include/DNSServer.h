@@ -0,0 +1,10 @@
+#pragma once
+#include <Arduino.h>
+
+class DNSServer {
+  public:
+    bool start(uint16_t, const String &, const IPAddress &) { return false; }
+    void stop() {}
+    void processNextRequest() {}
+    void setErrorReplyCode(int) {}
+};
@@ -0,0 +1,197 @@
+#pragma once
+// web server stubs: declarations only, the benchmark never serves requests
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include <FS.h>
+#include <vector>
+
+#define CONTENT_TYPE_JSON "application/json"
+#define CONTENT_TYPE_PLAIN "text/plain"
+#define CONTENT_TYPE_HTML "text/html"
+#define RESPONSE_TRY_AGAIN 0xFFFFFFFF
+
+typedef enum {
+  HTTP_GET = 0b00000001, HTTP_POST = 0b00000010, HTTP_DELETE = 0b00000100, HTTP_PUT = 0b00001000,
+  HTTP_PATCH = 0b00010000, HTTP_HEAD = 0b00100000, HTTP_OPTIONS = 0b01000000, HTTP_ANY = 0b01111111
+} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+
+typedef enum { WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA } AwsEventType;
+typedef enum { WS_CONTINUATION, WS_TEXT, WS_BINARY, WS_DISCONNECT = 0x08, WS_PING, WS_PONG } AwsFrameType;
+typedef struct { uint8_t message_opcode; uint32_t num; uint8_t final; uint8_t masked; uint8_t opcode; uint64_t len; uint8_t mask[4]; uint64_t index; } AwsFrameInfo;
+
+class AsyncWebServerRequest;
+class AsyncWebServerResponse;
+typedef std::function<void(AsyncWebServerRequest *request)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest *request, const String &filename, size_t index, uint8_t *data, size_t len, bool final)> ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total)> ArBodyHandlerFunction;
+typedef std::function<size_t(uint8_t *buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+typedef std::function<String(const String &)> AwsTemplateProcessor;
+
+class AsyncWebParameter {
+  public:
+    const String &name() const { return _name; }
+    const String &value() const { return _value; }
+    bool isPost() const { return false; }
+    bool isFile() const { return false; }
+  private:
+    String _name, _value;
+};
+
+class AsyncWebHeader {
+  public:
+    const String &name() const { return _name; }
+    const String &value() const { return _value; }
+  private:
+    String _name, _value;
+};
+
+class AsyncWebServerResponse {
+  public:
+    virtual ~AsyncWebServerResponse() {}
+    void setCode(int code) { _code = code; }
+    void setContentLength(size_t len) { _contentLength = len; }
+    void setContentType(const String &type) { _contentType = type; }
+    void addHeader(const String &, const String &) {}
+  protected:
+    int _code = 0;
+    String _contentType;
+    size_t _contentLength = 0;
+    size_t _sentLength = 0;
+};
+
+class AsyncAbstractResponse : public AsyncWebServerResponse {
+  public:
+    virtual bool _sourceValid() const { return false; }
+    virtual size_t _fillBuffer(uint8_t *, size_t) { return 0; }
+};
+
+class AsyncResponseStream : public AsyncWebServerResponse, public Print {
+  public:
+    size_t write(uint8_t) override { return 1; }
+    size_t write(const uint8_t *, size_t len) override { return len; }
+    using Print::write;
+};
+
+class AsyncWebServerRequest {
+  public:
+    void *_tempObject = nullptr;
+    WebRequestMethodComposite method() const { return HTTP_GET; }
+    const String &url() const { return _url; }
+    IPAddress client_ip() { return IPAddress(); }
+    AsyncClient *client() { return nullptr; }
+    void addInterestingHeader(const String &) {}
+    void send(int, const String & = String(), const String & = String()) {}
+    void send(AsyncWebServerResponse *response) { delete response; }
+    void send(FS &, const String &, const String & = String(), bool = false) {}
+    void sendChunked(const String &, AwsResponseFiller) {}
+    AsyncWebServerResponse *beginResponse(int, const String & = String(), const String & = String()) { return new AsyncWebServerResponse(); }
+    AsyncWebServerResponse *beginChunkedResponse(const String &, AwsResponseFiller) { return new AsyncWebServerResponse(); }
+    AsyncWebServerResponse *beginResponse_P(int, const String &, const uint8_t *, size_t) { return new AsyncWebServerResponse(); }
+    AsyncResponseStream *beginResponseStream(const String &, size_t = 1460) { return new AsyncResponseStream(); }
+    bool hasArg(const char *) const { return false; }
+    const String &arg(const char *) const { return _url; }
+    bool hasParam(const String &, bool = false, bool = false) const { return false; }
+    AsyncWebParameter *getParam(const String &, bool = false, bool = false) const { return nullptr; }
+    AsyncWebParameter *getParam(size_t) const { return nullptr; }
+    size_t params() const { return 0; }
+    bool hasHeader(const String &) const { return false; }
+    AsyncWebHeader *getHeader(const String &) const { return nullptr; }
+    void redirect(const String &) {}
+    bool authenticate(const char *, const char *) { return false; }
+    void requestAuthentication() {}
+  private:
+    String _url;
+};
+
+class AsyncWebHandler {
+  public:
+    virtual ~AsyncWebHandler() {}
+    virtual bool canHandle(AsyncWebServerRequest *) { return false; }
+    virtual void handleRequest(AsyncWebServerRequest *) {}
+    virtual void handleUpload(AsyncWebServerRequest *, const String &, size_t, uint8_t *, size_t, bool) {}
+    virtual void handleBody(AsyncWebServerRequest *, uint8_t *, size_t, size_t, size_t) {}
+    virtual bool isRequestHandlerTrivial() { return true; }
+};
+
+class AsyncWebSocket;
+class AsyncWebSocketMessageBuffer {
+  public:
+    explicit AsyncWebSocketMessageBuffer(size_t size = 0) : _data(size) {}
+    uint8_t *get() { return _data.data(); }
+    size_t length() const { return _data.size(); }
+  private:
+    std::vector<uint8_t> _data;
+};
+typedef AsyncWebSocketMessageBuffer *AsyncWebSocketBufferPtr;
+
+class AsyncWebSocketClient {
+  public:
+    uint32_t id() const { return 0; }
+    IPAddress remoteIP() { return IPAddress(); }
+    bool queueIsFull() const { return true; }
+    size_t queueLen() const { return 0; }
+    void text(const char *, size_t = 0) {}
+    void text(const String &) {}
+    void text(AsyncWebSocketMessageBuffer *) {}
+    void binary(const uint8_t *, size_t) {}
+    void binary(AsyncWebSocketMessageBuffer *) {}
+    void close(uint16_t = 0, const char * = nullptr) {}
+    void ping(const uint8_t * = nullptr, size_t = 0) {}
+    AsyncClient *client() { return nullptr; }
+};
+
+typedef std::function<void(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len)> AwsEventHandler;
+
+class AsyncWebSocket : public AsyncWebHandler {
+  public:
+    explicit AsyncWebSocket(const String &url) : _url(url) {}
+    size_t count() const { return 0; }
+    AsyncWebSocketClient *client(uint32_t) { return nullptr; }
+    bool hasClient(uint32_t) { return false; }
+    void onEvent(AwsEventHandler) {}
+    void cleanupClients(uint16_t = 4) {}
+    void textAll(const char *, size_t = 0) {}
+    void textAll(const String &) {}
+    void textAll(AsyncWebSocketMessageBuffer *buffer) { delete buffer; }
+    void binaryAll(const uint8_t *, size_t) {}
+    void binaryAll(AsyncWebSocketMessageBuffer *buffer) { delete buffer; }
+    void closeAll(uint16_t = 0, const char * = nullptr) {}
+    AsyncWebSocketMessageBuffer *makeBuffer(size_t size = 0) { return new AsyncWebSocketMessageBuffer(size); }
+    std::vector<AsyncWebSocketClient> &getClients() { return _clients; }
+  private:
+    String _url;
+    std::vector<AsyncWebSocketClient> _clients;
+};
+
+struct AsyncWebServerQueueLimits {
+  size_t nParallel;
+  size_t nMaxQueued;
+  size_t minHeap;
+  size_t heapUsage;
+};
+
+class AsyncCallbackWebHandler : public AsyncWebHandler {};
+
+class AsyncWebServer {
+  public:
+    AsyncWebServer(uint16_t port) : _port(port) {}
+    AsyncWebServer(uint16_t port, const AsyncWebServerQueueLimits &) : _port(port) {}
+    void begin() {}
+    void end() {}
+    AsyncWebHandler &addHandler(AsyncWebHandler *handler) { return *handler; }
+    bool removeHandler(AsyncWebHandler *) { return true; }
+    AsyncCallbackWebHandler &on(const char *, ArRequestHandlerFunction) { return _dummy; }
+    AsyncCallbackWebHandler &on(const char *, WebRequestMethodComposite, ArRequestHandlerFunction, ArUploadHandlerFunction = nullptr, ArBodyHandlerFunction = nullptr) { return _dummy; }
+    void onNotFound(ArRequestHandlerFunction) {}
+    void reset() {}
+  private:
+    uint16_t _port;
+    AsyncCallbackWebHandler _dummy;
+};
+
+class DefaultHeaders {
+  public:
+    static DefaultHeaders &Instance() { static DefaultHeaders h; return h; }
+    void addHeader(const String &, const String &) {}
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include "WString.h"
+#include "Print.h"
+
+class IPAddress {
+  public:
+    IPAddress() { _address.dword = 0; }
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) { _address.bytes[0] = a; _address.bytes[1] = b; _address.bytes[2] = c; _address.bytes[3] = d; }
+    IPAddress(uint32_t address) { _address.dword = address; }
+    IPAddress(const uint8_t *address) { memcpy(_address.bytes, address, 4); }
+    bool fromString(const char *address) { unsigned a, b, c, d; if (sscanf(address, "%u.%u.%u.%u", &a, &b, &c, &d) != 4) return false; *this = IPAddress(a, b, c, d); return true; }
+    bool fromString(const String &address) { return fromString(address.c_str()); }
+    operator uint32_t() const { return _address.dword; }
+    bool operator==(const IPAddress &addr) const { return _address.dword == addr._address.dword; }
+    bool operator!=(const IPAddress &addr) const { return _address.dword != addr._address.dword; }
+    bool operator==(const uint8_t *addr) const { return memcmp(addr, _address.bytes, 4) == 0; }
+    uint8_t operator[](int index) const { return _address.bytes[index]; }
+    uint8_t &operator[](int index) { return _address.bytes[index]; }
+    IPAddress &operator=(uint32_t address) { _address.dword = address; return *this; }
+    String toString() const { char buf[16]; snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _address.bytes[0], _address.bytes[1], _address.bytes[2], _address.bytes[3]); return String(buf); }
+    size_t printTo(Print &p) const { return p.print(toString()); }
+  private:
+    union { uint8_t bytes[4]; uint32_t dword; } _address;
+};
+
+extern const IPAddress INADDR_NONE;
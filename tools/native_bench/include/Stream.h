@@ -0,0 +1,25 @@
+#pragma once
+#include "Print.h"
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+    unsigned long getTimeout() const { return _timeout; }
+    virtual size_t readBytes(char *buffer, size_t length) { size_t n = 0; while (n < length) { int c = read(); if (c < 0) break; *buffer++ = (char)c; n++; } return n; }
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+    size_t readBytesUntil(char terminator, char *buffer, size_t length) {
+      size_t n = 0;
+      while (n < length) { int c = read(); if (c < 0 || c == terminator) break; *buffer++ = (char)c; n++; }
+      return n;
+    }
+    size_t readBytesUntil(char terminator, uint8_t *buffer, size_t length) { return readBytesUntil(terminator, (char *)buffer, length); }
+    String readString() { String r; int c; while ((c = read()) >= 0) r += (char)c; return r; }
+    String readStringUntil(char terminator) { String r; int c; while ((c = read()) >= 0 && c != terminator) r += (char)c; return r; }
+    bool find(const char *target) { size_t len = strlen(target), idx = 0; int c; while ((c = read()) >= 0) { if (c == target[idx]) { if (++idx == len) return true; } else idx = (c == target[0]); } return false; }
+    bool find(char target) { char t[2] = {target, 0}; return find(t); }
+  protected:
+    unsigned long _timeout = 1000;
+};
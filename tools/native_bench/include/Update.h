@@ -0,0 +1,15 @@
+#pragma once
+#include <Arduino.h>
+
+class UpdateClass {
+  public:
+    bool canRollBack() { return false; }
+    bool rollBack() { return false; }
+    bool begin(size_t, int = 0) { return false; }
+    size_t write(uint8_t *, size_t) { return 0; }
+    bool end(bool = false) { return false; }
+    bool hasError() { return true; }
+    bool isRunning() { return false; }
+    void abort() {}
+};
+extern UpdateClass Update;
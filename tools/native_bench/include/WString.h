@@ -0,0 +1,114 @@
+#pragma once
+// Arduino String on top of std::string (host build)
+#include <string>
+#include <algorithm>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include "pgmspace.h"
+
+class __FlashStringHelper;
+
+class String {
+  public:
+    String() {}
+    String(const char *cstr) : s(cstr ? cstr : "") {}
+    String(const char *cstr, unsigned len) : s(cstr ? std::string(cstr, len) : std::string()) {}
+    String(const std::string &str) : s(str) {}
+    String(const __FlashStringHelper *str) : s(reinterpret_cast<const char *>(str)) {}
+    String(char c) : s(1, c) {}
+    String(unsigned char v, unsigned char base = 10) { fromUnsigned(v, base); }
+    String(int v, unsigned char base = 10) { fromSigned(v, base); }
+    String(unsigned int v, unsigned char base = 10) { fromUnsigned(v, base); }
+    String(long v, unsigned char base = 10) { fromSigned(v, base); }
+    String(unsigned long v, unsigned char base = 10) { fromUnsigned(v, base); }
+    String(long long v, unsigned char base = 10) { fromSigned(v, base); }
+    String(unsigned long long v, unsigned char base = 10) { fromUnsigned(v, base); }
+    String(float v, unsigned char decimals = 2) { fromFloat(v, decimals); }
+    String(double v, unsigned char decimals = 2) { fromFloat(v, decimals); }
+
+    bool reserve(unsigned size) { s.reserve(size); return true; }
+    unsigned length() const { return s.length(); }
+    bool isEmpty() const { return s.empty(); }
+    const char *c_str() const { return s.c_str(); }
+    char *begin() { return &s[0]; }
+    char *end() { return &s[0] + s.length(); }
+    const char *begin() const { return s.c_str(); }
+    const char *end() const { return s.c_str() + s.length(); }
+
+    bool concat(const String &str) { s += str.s; return true; }
+    bool concat(const char *cstr) { if (cstr) s += cstr; return true; }
+    bool concat(const char *cstr, unsigned len) { if (cstr) s.append(cstr, len); return true; }
+    bool concat(char c) { s += c; return true; }
+    template<typename T> bool concat(T v) { return concat(String(v)); }
+
+    template<typename T> String &operator+=(const T &rhs) { concat(rhs); return *this; }
+    String &operator+=(const char *rhs) { concat(rhs); return *this; }
+
+    char charAt(unsigned index) const { return index < s.length() ? s[index] : 0; }
+    void setCharAt(unsigned index, char c) { if (index < s.length()) s[index] = c; }
+    char operator[](unsigned index) const { return charAt(index); }
+    char &operator[](unsigned index) { return s[index]; }
+
+    int compareTo(const String &rhs) const { return s.compare(rhs.s); }
+    bool equals(const String &rhs) const { return s == rhs.s; }
+    bool equals(const char *cstr) const { return s == (cstr ? cstr : ""); }
+    bool equalsIgnoreCase(const String &rhs) const { return strcasecmp(s.c_str(), rhs.s.c_str()) == 0; }
+    bool operator==(const String &rhs) const { return equals(rhs); }
+    bool operator==(const char *cstr) const { return equals(cstr); }
+    bool operator!=(const String &rhs) const { return !equals(rhs); }
+    bool operator!=(const char *cstr) const { return !equals(cstr); }
+    bool operator<(const String &rhs) const { return s < rhs.s; }
+    bool startsWith(const String &prefix, unsigned offset = 0) const { return s.compare(offset, prefix.s.length(), prefix.s) == 0; }
+    bool endsWith(const String &suffix) const { return s.length() >= suffix.s.length() && s.compare(s.length() - suffix.s.length(), suffix.s.length(), suffix.s) == 0; }
+
+    int indexOf(char c, unsigned from = 0) const { size_t p = s.find(c, from); return p == std::string::npos ? -1 : (int)p; }
+    int indexOf(const String &str, unsigned from = 0) const { size_t p = s.find(str.s, from); return p == std::string::npos ? -1 : (int)p; }
+    int lastIndexOf(char c) const { size_t p = s.rfind(c); return p == std::string::npos ? -1 : (int)p; }
+    int lastIndexOf(const String &str) const { size_t p = s.rfind(str.s); return p == std::string::npos ? -1 : (int)p; }
+    String substring(unsigned from) const { return from < s.length() ? String(s.substr(from)) : String(); }
+    String substring(unsigned from, unsigned to) const { if (from > to) std::swap(from, to); return from < s.length() ? String(s.substr(from, to - from)) : String(); }
+
+    void replace(const String &find, const String &repl) {
+      if (find.s.empty()) return;
+      for (size_t p = s.find(find.s); p != std::string::npos; p = s.find(find.s, p + repl.s.length())) s.replace(p, find.s.length(), repl.s);
+    }
+    void replace(char find, char repl) { std::replace(s.begin(), s.end(), find, repl); }
+    void remove(unsigned index) { if (index < s.length()) s.erase(index); }
+    void remove(unsigned index, unsigned count) { if (index < s.length()) s.erase(index, count); }
+    void toLowerCase() { for (auto &c : s) c = tolower(c); }
+    void toUpperCase() { for (auto &c : s) c = toupper(c); }
+    void trim() { size_t b = s.find_first_not_of(" \t\r\n"); size_t e = s.find_last_not_of(" \t\r\n"); s = (b == std::string::npos) ? std::string() : s.substr(b, e - b + 1); }
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return atof(s.c_str()); }
+    double toDouble() const { return atof(s.c_str()); }
+    void toCharArray(char *buf, unsigned bufsize, unsigned index = 0) const { getBytes((unsigned char *)buf, bufsize, index); }
+    void getBytes(unsigned char *buf, unsigned bufsize, unsigned index = 0) const {
+      if (!bufsize || !buf) return;
+      if (index >= s.length()) { buf[0] = 0; return; }
+      unsigned n = std::min<unsigned>(bufsize - 1, s.length() - index);
+      memcpy(buf, s.c_str() + index, n); buf[n] = 0;
+    }
+    explicit operator bool() const { return true; }
+
+    // ArduinoJson string adapter support
+    size_t write(uint8_t c) { s += (char)c; return 1; }
+
+  private:
+    std::string s;
+    void fromUnsigned(unsigned long long v, unsigned char base) { char buf[68]; char *p = buf + sizeof(buf) - 1; *p = 0; do { unsigned d = v % base; *--p = d < 10 ? '0' + d : 'A' + d - 10; v /= base; } while (v); s = p; }
+    void fromSigned(long long v, unsigned char base) { if (base == 10 && v < 0) { fromUnsigned(-(unsigned long long)v, 10); s.insert(0, 1, '-'); } else fromUnsigned((unsigned long long)v, base); }
+    void fromFloat(double v, unsigned char decimals) { char buf[48]; snprintf(buf, sizeof(buf), "%.*f", decimals, v); s = buf; }
+};
+
+class StringSumHelper : public String {
+  public:
+    using String::String;
+    StringSumHelper(const String &s) : String(s) {}
+};
+
+inline String operator+(const String &lhs, const String &rhs) { String r(lhs); r.concat(rhs); return r; }
+inline String operator+(const String &lhs, const char *rhs) { String r(lhs); r.concat(rhs); return r; }
+inline String operator+(const char *lhs, const String &rhs) { String r(lhs); r.concat(rhs); return r; }
+inline String operator+(const String &lhs, char rhs) { String r(lhs); r.concat(rhs); return r; }
@@ -0,0 +1,43 @@
+#pragma once
+// WiFi stubs: the host is never connected
+#include <Arduino.h>
+
+typedef enum { WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL, WL_SCAN_COMPLETED, WL_CONNECTED, WL_CONNECT_FAILED, WL_CONNECTION_LOST, WL_DISCONNECTED, WL_NO_SHIELD = 255 } wl_status_t;
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } wifi_mode_t;
+#define WIFI_MODE_NULL  WIFI_OFF
+#define WIFI_MODE_STA   WIFI_STA
+#define WIFI_MODE_AP    WIFI_AP
+#define WIFI_MODE_APSTA WIFI_AP_STA
+typedef enum { WIFI_POWER_19_5dBm = 78, WIFI_POWER_8_5dBm = 34 } wifi_power_t;
+typedef int32_t arduino_event_id_t;
+typedef arduino_event_id_t WiFiEvent_t;
+typedef void *arduino_event_info_t;
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED  (-2)
+
+class WiFiClass {
+  public:
+    wl_status_t status() { return WL_DISCONNECTED; }
+    bool isConnected() { return false; }
+    IPAddress localIP() { return IPAddress(); }
+    IPAddress subnetMask() { return IPAddress(); }
+    IPAddress gatewayIP() { return IPAddress(); }
+    IPAddress softAPIP() { return IPAddress(); }
+    IPAddress broadcastIP() { return IPAddress(); }
+    String macAddress() { return String("00:00:00:00:00:00"); }
+    uint8_t *macAddress(uint8_t *mac) { memset(mac, 0, 6); return mac; }
+    String softAPmacAddress() { return macAddress(); }
+    String SSID() { return String(); }
+    int8_t RSSI() { return 0; }
+    int32_t channel() { return 0; }
+    wifi_mode_t getMode() { return WIFI_OFF; }
+    bool mode(wifi_mode_t) { return true; }
+    int softAPgetStationNum() { return 0; }
+    bool disconnect(bool = false, bool = false) { return true; }
+    bool softAPdisconnect(bool = false) { return true; }
+    int hostByName(const char *, IPAddress &) { return 0; }
+    int16_t scanComplete() { return WIFI_SCAN_FAILED; }
+    int16_t scanNetworks(bool = false, bool = false) { return WIFI_SCAN_FAILED; }
+    void scanDelete() {}
+};
+extern WiFiClass WiFi;
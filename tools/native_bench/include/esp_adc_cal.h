@@ -0,0 +1,7 @@
+#pragma once
+#include <stdint.h>
+typedef enum { ADC_UNIT_1 = 1 } adc_unit_t;
+typedef enum { ADC_ATTEN_DB_0, ADC_ATTEN_DB_2_5, ADC_ATTEN_DB_6, ADC_ATTEN_DB_12 } adc_atten_t;
+typedef enum { ADC_WIDTH_BIT_12 = 3, ADC_WIDTH_BIT_13 = 4 } adc_bits_width_t;
+typedef struct { uint32_t coeff_a, coeff_b; const uint32_t *low_curve, *high_curve; } esp_adc_cal_characteristics_t;
+inline int esp_adc_cal_characterize(adc_unit_t, adc_atten_t, adc_bits_width_t, uint32_t, esp_adc_cal_characteristics_t *ch) { *ch = {0, 0, nullptr, nullptr}; return 0; }
@@ -0,0 +1,5 @@
+#pragma once
+#include <stdint.h>
+typedef enum { CHIP_ESP32 = 1 } esp_chip_model_t;
+typedef struct { esp_chip_model_t model; uint32_t features; uint16_t full_revision; uint8_t cores; uint8_t revision; } esp_chip_info_t;
+inline void esp_chip_info(esp_chip_info_t *info) { *info = {CHIP_ESP32, 0, 300, 2, 3}; }
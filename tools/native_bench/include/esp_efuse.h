@@ -0,0 +1,4 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+inline int esp_efuse_mac_get_default(uint8_t *mac) { memset(mac, 0, 6); return 0; }
@@ -0,0 +1,36 @@
+#pragma once
+// heap_caps API on top of the host allocator; free/used sizes are reported against a simulated ESP32 heap
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_EXEC     (1<<0)
+#define MALLOC_CAP_32BIT    (1<<1)
+#define MALLOC_CAP_8BIT     (1<<2)
+#define MALLOC_CAP_DMA      (1<<3)
+#define MALLOC_CAP_SPIRAM   (1<<10)
+#define MALLOC_CAP_INTERNAL (1<<11)
+#define MALLOC_CAP_DEFAULT  (1<<12)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+void  *heap_caps_malloc(size_t size, uint32_t caps);
+void  *heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+void  *heap_caps_realloc(void *ptr, size_t size, uint32_t caps);
+void  *heap_caps_malloc_prefer(size_t size, size_t num, ...);
+void  *heap_caps_calloc_prefer(size_t n, size_t size, size_t num, ...);
+void  *heap_caps_realloc_prefer(void *ptr, size_t size, size_t num, ...);
+void   heap_caps_free(void *ptr);
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+size_t heap_caps_get_total_size(uint32_t caps);
+size_t heap_caps_get_minimum_free_size(uint32_t caps);
+inline bool esp_ptr_external_ram(const void *) { return false; }
+inline bool esp_ptr_internal(const void *) { return true; }
+inline void *ps_malloc(size_t size) { return malloc(size); }
+inline void *ps_calloc(size_t n, size_t size) { return calloc(n, size); }
+inline void *ps_realloc(void *ptr, size_t size) { return realloc(ptr, size); }
+#ifdef __cplusplus
+}
+#endif
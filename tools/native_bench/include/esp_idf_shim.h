@@ -0,0 +1,29 @@
+#pragma once
+// ESP-IDF version/target macros the WLED sources test for (host build pretends to be a classic ESP32 on IDF 4.4)
+#ifndef ESP_IDF_VERSION_VAL
+#define ESP_IDF_VERSION_VAL(major, minor, patch) ((major << 16) | (minor << 8) | (patch))
+#define ESP_IDF_VERSION_MAJOR 4
+#define ESP_IDF_VERSION_MINOR 4
+#define ESP_IDF_VERSION_PATCH 7
+#define ESP_IDF_VERSION ESP_IDF_VERSION_VAL(ESP_IDF_VERSION_MAJOR, ESP_IDF_VERSION_MINOR, ESP_IDF_VERSION_PATCH)
+#endif
+#ifndef ESP_ARDUINO_VERSION_VAL
+#define ESP_ARDUINO_VERSION_VAL(major, minor, patch) ((major << 16) | (minor << 8) | (patch))
+#define ESP_ARDUINO_VERSION ESP_ARDUINO_VERSION_VAL(2, 0, 17)
+#endif
+#ifndef GPIO_PIN_COUNT
+#define GPIO_PIN_COUNT 40
+#endif
+#ifndef SOC_GPIO_PIN_COUNT
+#define SOC_GPIO_PIN_COUNT GPIO_PIN_COUNT
+#endif
+#ifndef ARDUINO
+#define ARDUINO 10816
+#endif
+#ifndef SOC_DRAM_LOW
+#define SOC_DRAM_LOW  0 // no address range check on the host
+#define SOC_DRAM_HIGH 0
+#endif
+typedef enum { ESP_RST_UNKNOWN, ESP_RST_POWERON, ESP_RST_EXT, ESP_RST_SW, ESP_RST_PANIC, ESP_RST_INT_WDT, ESP_RST_TASK_WDT, ESP_RST_WDT, ESP_RST_DEEPSLEEP, ESP_RST_BROWNOUT, ESP_RST_SDIO } esp_reset_reason_t;
+inline esp_reset_reason_t esp_reset_reason() { return ESP_RST_POWERON; }
+#include "esp_heap_caps.h"
@@ -0,0 +1,25 @@
+#pragma once
+// FreeRTOS subset on top of the C++ standard library (host build)
+#include <stdint.h>
+#include <mutex>
+#include <atomic>
+
+typedef int32_t  BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE  ((BaseType_t)1)
+#define pdPASS  pdTRUE
+#define pdFAIL  pdFALSE
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define configMAX_PRIORITIES 25
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+struct portMUX_TYPE { std::atomic_flag flag = ATOMIC_FLAG_INIT; };
+#define portMUX_INITIALIZER_UNLOCKED {}
+inline void portENTER_CRITICAL(portMUX_TYPE *mux) { while (mux->flag.test_and_set(std::memory_order_acquire)) {} }
+inline void portEXIT_CRITICAL(portMUX_TYPE *mux) { mux->flag.clear(std::memory_order_release); }
+#define portENTER_CRITICAL_ISR portENTER_CRITICAL
+#define portEXIT_CRITICAL_ISR  portEXIT_CRITICAL
@@ -0,0 +1,17 @@
+#pragma once
+#include "FreeRTOS.h"
+#include <chrono>
+
+struct NativeSemaphore { std::recursive_timed_mutex mutex; };
+typedef NativeSemaphore *SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { return new NativeSemaphore(); }
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { return new NativeSemaphore(); }
+inline void vSemaphoreDelete(SemaphoreHandle_t s) { delete s; }
+inline BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t s, TickType_t ticks) {
+  if (ticks == portMAX_DELAY) { s->mutex.lock(); return pdTRUE; }
+  return s->mutex.try_lock_for(std::chrono::milliseconds(ticks)) ? pdTRUE : pdFALSE;
+}
+inline BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t s) { s->mutex.unlock(); return pdTRUE; }
+#define xSemaphoreTake xSemaphoreTakeRecursive
+#define xSemaphoreGive xSemaphoreGiveRecursive
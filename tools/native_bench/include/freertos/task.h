@@ -0,0 +1,49 @@
+#pragma once
+#include "FreeRTOS.h"
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+
+typedef void (*TaskFunction_t)(void *);
+
+// a host thread with a FreeRTOS-like notification counter
+struct NativeTask {
+  std::thread             thread;
+  std::mutex              mutex;
+  std::condition_variable cv;
+  uint32_t                notifications = 0;
+};
+typedef NativeTask *TaskHandle_t;
+
+inline thread_local NativeTask *nativeCurrentTask = nullptr;
+
+// core affinity and priority are ignored, the host scheduler decides
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *, uint32_t, void *arg, UBaseType_t, TaskHandle_t *handle, BaseType_t) {
+  NativeTask *t = new NativeTask();
+  t->thread = std::thread([t, fn, arg]() { nativeCurrentTask = t; fn(arg); });
+  t->thread.detach();
+  if (handle) *handle = t;
+  return pdPASS;
+}
+inline void vTaskDelay(TickType_t ticks) { std::this_thread::sleep_for(std::chrono::milliseconds(ticks)); }
+inline void vTaskDelete(TaskHandle_t) {}
+inline BaseType_t xPortGetCoreID() { return 1; }
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t t) {
+  std::lock_guard<std::mutex> lock(t->mutex);
+  t->notifications++;
+  t->cv.notify_one();
+  return pdPASS;
+}
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  NativeTask *t = nativeCurrentTask;
+  if (!t) return 0;
+  std::unique_lock<std::mutex> lock(t->mutex);
+  const auto pending = [t]() { return t->notifications > 0; };
+  if (ticks == portMAX_DELAY) t->cv.wait(lock, pending);
+  else                        t->cv.wait_for(lock, std::chrono::milliseconds(ticks), pending);
+  uint32_t n = t->notifications;
+  if (clearOnExit) t->notifications = 0;
+  else if (n)      t->notifications--;
+  return n;
+}
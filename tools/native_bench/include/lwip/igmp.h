@@ -0,0 +1,6 @@
+#pragma once
+#include "ip_addr.h"
+#include "err.h"
+#include <arpa/inet.h>
+inline err_t igmp_joingroup(const ip4_addr_t *, const ip4_addr_t *) { return ERR_OK; }
+#define IP4_ADDR_ANY4 nullptr
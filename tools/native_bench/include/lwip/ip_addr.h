@@ -0,0 +1,5 @@
+#pragma once
+#include <stdint.h>
+#define LWIP_VERSION_MAJOR 2
+typedef struct { uint32_t addr; } ip4_addr_t;
+typedef struct { union { ip4_addr_t ip4; } u_addr; uint8_t type; } ip_addr_t;
@@ -0,0 +1,10 @@
+#pragma once
+// SHA1 is not needed by the benchmark; the context API is kept so util.cpp compiles (digest is all zeros)
+#include <stddef.h>
+#include <string.h>
+typedef struct { int dummy; } mbedtls_sha1_context;
+inline void mbedtls_sha1_init(mbedtls_sha1_context *) {}
+inline void mbedtls_sha1_free(mbedtls_sha1_context *) {}
+inline int mbedtls_sha1_starts_ret(mbedtls_sha1_context *) { return 0; }
+inline int mbedtls_sha1_update_ret(mbedtls_sha1_context *, const unsigned char *, size_t) { return 0; }
+inline int mbedtls_sha1_finish_ret(mbedtls_sha1_context *, unsigned char output[20]) { memset(output, 0, 20); return 0; }
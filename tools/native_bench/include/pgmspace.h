@@ -0,0 +1,52 @@
+#pragma once
+// flash access is plain memory access on the host
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#define PROGMEM
+#define PGM_P const char *
+#define PGM_VOID_P const void *
+#define PSTR(s) (s)
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+#define ICACHE_RAM_ATTR
+
+class __FlashStringHelper;
+#define FPSTR(pstr_pointer) (reinterpret_cast<const __FlashStringHelper *>(pstr_pointer))
+#define F(string_literal) (FPSTR(PSTR(string_literal)))
+
+#define pgm_read_byte(addr)   (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)   (*(const uint16_t *)(addr))
+// like the ESP32 core this reads an unsigned long, so pointer tables read with pgm_read_dword() stay intact on LP64 hosts
+#define pgm_read_dword(addr)  (*(const unsigned long *)(addr))
+#define pgm_read_float(addr)  (*(const float *)(addr))
+#define pgm_read_ptr(addr)    (*(const void * const *)(addr))
+#define pgm_read_byte_near(addr)  pgm_read_byte(addr)
+#define pgm_read_word_near(addr)  pgm_read_word(addr)
+#define pgm_read_dword_near(addr) pgm_read_dword(addr)
+#define pgm_read_byte_far(addr)   pgm_read_byte(addr)
+#define pgm_read_word_far(addr)   pgm_read_word(addr)
+
+#define memcpy_P      memcpy
+#define memcmp_P      memcmp
+#define memccpy_P     memccpy
+#define strlen_P      strlen
+#define strnlen_P     strnlen
+#define strcpy_P      strcpy
+#define strncpy_P     strncpy
+#define strcat_P      strcat
+#define strncat_P     strncat
+#define strcmp_P      strcmp
+#define strncmp_P     strncmp
+#define strcasecmp_P  strcasecmp
+#define strncasecmp_P strncasecmp
+#define strstr_P      strstr
+#define strchr_P      strchr
+#define strrchr_P     strrchr
+#define sprintf_P     sprintf
+#define snprintf_P    snprintf
+#define vsnprintf_P   vsnprintf
+#define printf_P      printf
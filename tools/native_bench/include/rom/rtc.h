@@ -0,0 +1,3 @@
+#pragma once
+typedef enum { NO_MEAN = 0, POWERON_RESET = 1, SW_RESET = 3, RTCWDT_BROWN_OUT_RESET = 15 } RESET_REASON;
+inline RESET_REASON rtc_get_reset_reason(int) { return POWERON_RESET; }
@@ -0,0 +1,6 @@
+#pragma once
+// hardware RNG register: read through a host PRNG
+#include <stdint.h>
+uint32_t nativeBenchRandomRegister();
+#define WDEV_RND_REG 0
+#define REG_READ(reg) nativeBenchRandomRegister()
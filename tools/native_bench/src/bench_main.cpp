@@ -0,0 +1,184 @@
+/*
+ * Host-native FX benchmark runner
+ * Runs every effect registered via WS2812FX::addEffect() on a 1D strip and a 2D matrix and reports
+ * the average/maximum wall-clock time of one strip.service() call (effect + blend + bus output)
+ * and the heap used by the effect (segment data and any other allocation made while it runs).
+ * For 2D particle system effects the number of particle pairs checked for collisions per frame is reported as well.
+ *
+ * usage: wled_bench [-1 <leds>] [-2 <width>x<height>] [-b <outputs>] [-f <frames>] [-w <warmup>] [-m <id>] [-s <fps>] [-B <pixels>] [-N] [-L] [-c]
+ *   -1  number of LEDs of the 1D strip (default 300, 0 to skip)
+ *   -2  matrix size (default 32x32, 0 to skip)
+ *   -b  number of outputs (buses) the LEDs are split across (default 1)
+ *   -f  timed frames per effect (default 200)
+ *   -w  untimed warm-up frames per effect (default 20)
+ *   -m  only run effect with given ID
+ *   -s  simulated frame rate used to advance effect time (default WLED_FPS)
+ *   -B  also compare the blend mode kernels with the reference implementation on the given number of pixels
+ *   -N  also compare the batch noise functions with per pixel noise and time the noise effects on the matrix
+ *   -L  also compare the 2D box/gaussian blur with a reference box average on the matrix
+ *   -c  CSV output
+ */
+#include "wled.h"
+#include "native_bench.h"
+#include "FXparticleSystem.h"
+#include <chrono>
+#include <unistd.h>
+
+struct BenchOptions {
+  unsigned leds1D   = 300;
+  unsigned width2D  = 32;
+  unsigned height2D = 32;
+  unsigned outputs  = 1;
+  unsigned frames   = 200;
+  unsigned warmup   = 20;
+  int      mode     = -1;
+  unsigned fps      = WLED_FPS;
+  unsigned blend    = 0;
+  bool     noise    = false;
+  bool     blur     = false;
+  bool     csv      = false;
+};
+
+// 2D-only effects are flagged with '2' (and without '1') in the 4th metadata field
+static bool is2DOnly(const char *modeData) {
+  const char *p = strchr(modeData, '@');
+  for (int field = 0; p && field < 3; field++) p = strchr(p + 1, ';');
+  if (!p) return false;
+  bool has1D = false, has2D = false;
+  for (++p; *p && *p != ';'; p++) { has1D |= (*p == '1'); has2D |= (*p == '2'); }
+  return has2D && !has1D;
+}
+
+static void setupStrip(unsigned width, unsigned height, unsigned outputs) {
+  strip.waitForIt(); // output of last frame may still be running (WLED_ENABLE_OUTPUT_TASK)
+  strip.resetSegments();
+  strip.isMatrix = (height > 1);
+#ifndef WLED_DISABLE_2D
+  strip.panel.clear();
+  if (strip.isMatrix) {
+    WS2812FX::Panel p;
+    p.width  = width;
+    p.height = height;
+    strip.panel.push_back(p);
+  }
+#endif
+  const unsigned total = width * height;
+  if (outputs < 1) outputs = 1;
+  if (outputs > total) outputs = total;
+  for (unsigned b = 0, start = 0; b < outputs; b++) {
+    uint8_t pins[OUTPUT_MAX_PINS] = {uint8_t(2 + b), 255, 255, 255, 255};
+    const unsigned len = total / outputs + (b < total % outputs);
+    busConfigs.emplace_back(TYPE_WS2812_RGB, pins, start, len, COL_ORDER_GRB);
+    start += len;
+  }
+  strip.finalizeInit();
+  strip.makeAutoSegments(true);
+  strip.setTransition(0);
+  strip.setTargetFps(FPS_UNLIMITED);
+  strip.setBrightness(128, true);
+}
+
+static void runLayout(const BenchOptions &opt, unsigned width, unsigned height) {
+  setupStrip(width, height, opt.outputs);
+  const bool matrix = strip.isMatrix;
+  const unsigned frameTimeUs = 1000000 / (opt.fps ? opt.fps : WLED_FPS);
+  char layout[16];
+  snprintf(layout, sizeof(layout), matrix ? "%ux%u" : "%u", width, matrix ? height : 0);
+
+  if (!opt.csv) {
+    printf("\n%s layout %s (%u LEDs, %u outputs), %u frames\n", matrix ? "2D" : "1D", layout, strip.getLengthTotal(), (unsigned)BusManager::getNumBusses(), opt.frames);
+    printf("%4s  %-28s %10s %10s %10s %10s %10s\n", "id", "effect", "us/frame", "max us", "data B", "heap B", "coll/frame");
+  }
+
+  double totalUs = 0;
+  unsigned count = 0;
+  for (unsigned id = 0; id < strip.getModeCount(); id++) {
+    if (opt.mode >= 0 && (unsigned)opt.mode != id) continue;
+    const char *modeData = strip.getModeData(id);
+    if (strcmp_P(modeData, PSTR("RSVD")) == 0) continue; // unused slot
+    if (!matrix && is2DOnly(modeData)) continue;
+
+    Segment &seg = strip.getMainSegment();
+    seg.setMode(FX_MODE_STATIC);
+    strip.service();
+    seg.deallocateData();          // so that the heap column includes the effect's own data
+    Segment::trimDataArena();
+    nativeBenchSeedRandom(id + 1); // make runs reproducible
+    nativeBenchHeapReset();
+    seg.setMode(id, true);
+
+    for (unsigned f = 0; f < opt.warmup; f++) { nativeBenchAdvance(frameTimeUs); strip.service(); }
+
+    double sumUs = 0, maxUs = 0;
+#ifndef WLED_DISABLE_PARTICLESYSTEM2D
+    ParticleSystem2D::collisionChecks = 0;
+#endif
+    size_t peakHeap = nativeBenchHeapUsed();
+    for (unsigned f = 0; f < opt.frames; f++) {
+      nativeBenchAdvance(frameTimeUs);
+      auto t0 = std::chrono::steady_clock::now();
+      strip.service();
+      double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+      sumUs += us;
+      if (us > maxUs) maxUs = us;
+      size_t heap = nativeBenchHeapUsed();
+      if (heap > peakHeap) peakHeap = heap;
+    }
+    double avgUs = opt.frames ? sumUs / opt.frames : 0;
+    unsigned checks = 0;
+#ifndef WLED_DISABLE_PARTICLESYSTEM2D
+    if (opt.frames) checks = ParticleSystem2D::collisionChecks / opt.frames;
+#endif
+    totalUs += avgUs;
+    count++;
+
+    char name[64];
+    extractModeName(id, nullptr, name, sizeof(name)-1);
+    if (opt.csv) printf("%s,%s,%u,\"%s\",%.2f,%.2f,%u,%u,%u\n", matrix ? "2D" : "1D", layout, id, name, avgUs, maxUs, (unsigned)seg.dataSize(), (unsigned)peakHeap, checks);
+    else         printf("%4u  %-28.28s %10.2f %10.2f %10u %10u %10u\n", id, name, avgUs, maxUs, (unsigned)seg.dataSize(), (unsigned)peakHeap, checks);
+  }
+  if (!opt.csv && count) printf("%u effects, mean %.2f us/frame (%.1f FPS max)\n", count, totalUs / count, totalUs > 0 ? 1e6 * count / totalUs : 0.0);
+}
+
+int main(int argc, char **argv) {
+  BenchOptions opt;
+  int c;
+  while ((c = getopt(argc, argv, "1:2:b:f:w:m:s:B:NLch")) != -1) {
+    switch (c) {
+      case '1': opt.leds1D = atoi(optarg); break;
+      case '2': if (sscanf(optarg, "%ux%u", &opt.width2D, &opt.height2D) != 2) opt.width2D = opt.height2D = 0; break;
+      case 'b': opt.outputs = atoi(optarg); break;
+      case 'f': opt.frames = atoi(optarg); break;
+      case 'w': opt.warmup = atoi(optarg); break;
+      case 'm': opt.mode = atoi(optarg); break;
+      case 's': opt.fps = atoi(optarg); break;
+      case 'B': opt.blend = atoi(optarg); break;
+      case 'N': opt.noise = true; break;
+      case 'L': opt.blur = true; break;
+      case 'c': opt.csv = true; break;
+      default:
+        fprintf(stderr, "usage: %s [-1 leds] [-2 WxH] [-b outputs] [-f frames] [-w warmup] [-m id] [-s fps] [-B pixels] [-N] [-L] [-c]\n", argv[0]);
+        return c == 'h' ? 0 : 1;
+    }
+  }
+  if (opt.width2D > 255 || opt.height2D > 255) { fprintf(stderr, "matrix dimensions are limited to 255x255\n"); return 1; }
+
+  NeoGammaWLEDMethod::calcGammaTable(gammaCorrectVal); // fill look-up tables (done by deserializeConfig() on a device)
+  if (opt.csv) printf("layout,size,id,effect,us_per_frame,max_us,data_bytes,heap_bytes,collision_checks\n");
+  if (opt.leds1D) runLayout(opt, opt.leds1D, 1);
+#ifndef WLED_DISABLE_2D
+  if (opt.width2D > 1 && opt.height2D > 1) runLayout(opt, opt.width2D, opt.height2D);
+#endif
+  if (opt.blend && runBlendBench(opt.blend, opt.frames, opt.csv)) return 2;
+#ifndef WLED_DISABLE_2D
+  if (opt.noise && opt.width2D > 1 && opt.height2D > 1) {
+    setupStrip(opt.width2D, opt.height2D, opt.outputs);
+    if (runNoiseBench(opt.width2D, opt.height2D, opt.frames, opt.csv)) return 2;
+  }
+  if (opt.blur && opt.width2D > 1 && opt.height2D > 1) {
+    setupStrip(opt.width2D, opt.height2D, opt.outputs);
+    if (runBlurBench(opt.width2D, opt.height2D, opt.frames, opt.csv)) return 2;
+  }
+#endif
+  return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * Host-native blend mode benchmark
+ * Compares the per-mode blend kernels of WS2812FX::getBlendKernel() with the per-channel function table
+ * blendSegment() used before (kept here as reference): checks that both produce identical pixels for all
+ * blend modes and reports the time to blend one frame of pixels with either of them.
+ */
+#include "wled.h"
+#include "native_bench.h"
+#include <chrono>
+
+// reference: per channel blend functions and per pixel mode switch as used by blendSegment() before the kernels
+static uint8_t _subtract  (uint8_t a, uint8_t b) { return b > a ? (b - a) : 0; }
+static uint8_t _difference(uint8_t a, uint8_t b) { return b > a ? (b - a) : (a - b); }
+static uint8_t _average   (uint8_t a, uint8_t b) { return (a + b) >> 1; }
+#if !defined(WLED_HAVE_FAST_int_DIVIDE)
+static uint8_t _multiply  (uint8_t a, uint8_t b) { return ((a * b) + 255) >> 8; }
+#else
+static uint8_t _multiply  (uint8_t a, uint8_t b) { return (a * b) / 255; }
+#endif
+static uint8_t _divide    (uint8_t a, uint8_t b) { return a > b ? (b * 255) / a : 255; }
+static uint8_t _lighten   (uint8_t a, uint8_t b) { return a > b ? a : b; }
+static uint8_t _darken    (uint8_t a, uint8_t b) { return a < b ? a : b; }
+static uint8_t _screen    (uint8_t a, uint8_t b) { return 255 - _multiply(~a,~b); }
+static uint8_t _overlay   (uint8_t a, uint8_t b) { return b < 128 ? 2 * _multiply(a,b) : (255 - 2 * _multiply(~a,~b)); }
+static uint8_t _hardlight (uint8_t a, uint8_t b) { return a < 128 ? 2 * _multiply(a,b) : (255 - 2 * _multiply(~a,~b)); }
+#if !defined(WLED_HAVE_FAST_int_DIVIDE)
+static uint8_t _softlight (uint8_t a, uint8_t b) { return (((b * b * (255 - 2 * a))) + ((2 * a * b + 256) << 8)) >> 16; }
+#else
+static uint8_t _softlight (uint8_t a, uint8_t b) { return (b * b * (255 - 2 * a) + 255 * 2 * a * b) / (255 * 255); }
+#endif
+static uint8_t _dodge     (uint8_t a, uint8_t b) { return _divide(~a,b); }
+static uint8_t _burn      (uint8_t a, uint8_t b) { return ~_divide(a,~b); }
+static uint8_t _dummy     (uint8_t a, uint8_t b) { return a; }
+
+static void referenceBlend(uint32_t *dst, const uint32_t *src, size_t count, size_t mode, uint8_t opacity) {
+  typedef uint8_t(*FuncType)(uint8_t, uint8_t);
+  FuncType funcs[] = {
+    _dummy,      _dummy,     _dummy,    _subtract,
+    _difference, _average,   _dummy,    _divide,
+    _lighten,    _darken,    _screen,   _overlay,
+    _hardlight,  _softlight, _dodge,    _burn,
+    _dummy
+  };
+  const size_t blendMode = mode < BLENDMODES ? mode : 0;
+  const auto segblend = [&](uint32_t t, uint32_t b){
+    switch (blendMode) {
+      case 0 : return t;
+      case 1 : return b;
+      case 2 : return color_add(t,b,true);
+      case 6 : return RGBW32(_multiply(R(t),R(b)), _multiply(G(t),G(b)), _multiply(B(t),B(b)), _multiply(W(t),W(b)));
+      case 16: return t ? t : b;
+    }
+    const auto func = funcs[blendMode];
+    return RGBW32(func(R(t),R(b)), func(G(t),G(b)), func(B(t),B(b)), func(W(t),W(b)));
+  };
+  for (size_t i = 0; i < count; i++) dst[i] = color_blend(dst[i], segblend(src[i], dst[i]), opacity);
+}
+
+static const char *const blendModeNames[BLENDMODES] = {
+  "top", "bottom", "add", "subtract", "difference", "average", "multiply", "divide", "lighten",
+  "darken", "screen", "overlay", "hard light", "soft light", "dodge", "burn", "stencil"
+};
+
+// returns the number of mode/opacity runs that did not match the reference
+unsigned runBlendBench(unsigned pixels, unsigned frames, bool csv) {
+  if (pixels == 0) pixels = 1;
+  std::vector<uint32_t> top(pixels), bottom(pixels), ref(pixels), out(pixels);
+  nativeBenchSeedRandom(1);
+  for (unsigned i = 0; i < pixels; i++) {
+    top[i]    = (i % 7 == 0) ? 0 : (uint32_t(hw_random16()) << 16 | hw_random16()); // some black pixels for stencil
+    bottom[i] = uint32_t(hw_random16()) << 16 | hw_random16();
+  }
+  // exhaustive check of all channel value pairs (in all 4 channels at once) besides the random pixels
+  std::vector<uint32_t> allTop(65536), allBottom(65536), allRef(65536), allOut(65536);
+  for (unsigned i = 0; i < 65536; i++) {
+    const uint8_t a = i >> 8, b = i & 0xFF;
+    allTop[i]    = RGBW32(a, a ^ 0x55, b, ~a);
+    allBottom[i] = RGBW32(b, b ^ 0xAA, a, ~b);
+  }
+
+  if (!csv) {
+    printf("\nblend modes, %u pixels, %u frames\n", pixels, frames);
+    printf("%4s  %-12s %8s %12s %12s %8s\n", "mode", "name", "opacity", "ref us", "kernel us", "result");
+  }
+  unsigned mismatches = 0;
+  const uint8_t opacities[] = {255, 128};
+  for (unsigned mode = 0; mode < BLENDMODES; mode++) {
+    const WS2812FX::BlendKernel kernel = WS2812FX::getBlendKernel(mode);
+    for (uint8_t opacity : opacities) {
+      allRef = allBottom; allOut = allBottom;
+      referenceBlend(allRef.data(), allTop.data(), allRef.size(), mode, opacity);
+      kernel.run(allOut.data(), 1, allTop.data(), 1, allOut.size(), opacity);
+      bool match = (allRef == allOut);
+      for (unsigned i = 0; match && i < 65536; i += 257) match = (kernel.pixel(allTop[i], allBottom[i], opacity) == allRef[i]);
+
+      double refUs = 0, kernelUs = 0;
+      for (unsigned f = 0; f < frames; f++) {
+        ref = bottom; out = bottom; // blending is done in place
+        auto t0 = std::chrono::steady_clock::now();
+        referenceBlend(ref.data(), top.data(), pixels, mode, opacity);
+        auto t1 = std::chrono::steady_clock::now();
+        kernel.run(out.data(), 1, top.data(), 1, pixels, opacity);
+        auto t2 = std::chrono::steady_clock::now();
+        refUs    += std::chrono::duration<double, std::micro>(t1 - t0).count();
+        kernelUs += std::chrono::duration<double, std::micro>(t2 - t1).count();
+        match &= (ref == out);
+      }
+      if (frames) { refUs /= frames; kernelUs /= frames; }
+      if (!match) mismatches++;
+      if (csv) printf("blend,%u,%u,\"%s\",%u,%.2f,%.2f,%s\n", pixels, mode, blendModeNames[mode], opacity, refUs, kernelUs, match ? "ok" : "MISMATCH");
+      else     printf("%4u  %-12s %8u %12.2f %12.2f %8s\n", mode, blendModeNames[mode], opacity, refUs, kernelUs, match ? "ok" : "MISMATCH");
+    }
+  }
+  if (!csv) printf("%u of %u runs differ from the reference\n", mismatches, (unsigned)(BLENDMODES * sizeof(opacities)));
+  return mismatches;
+}
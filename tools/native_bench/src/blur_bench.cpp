@@ -0,0 +1,98 @@
+/*
+ * Host-native 2D blur benchmark
+ * Compares Segment::box_blur() (running sum, box and 3-pass gaussian) with a straightforward box average over
+ * the clamped window (kept here as reference): checks that no channel differs by more than one per pass (the running sum
+ * divides by multiplying with a rounded reciprocal) and reports
+ * the time to blur one frame with either of them and with the carry blur blur2D() for comparison.
+ */
+#include "wled.h"
+#include "native_bench.h"
+#include <chrono>
+
+// reference: average of the 2*radius+1 pixels around each pixel of a line, pixels beyond the ends repeat the edge pixels
+static void referenceBoxLine(uint32_t *p, unsigned stride, unsigned count, unsigned radius, std::vector<uint32_t> &line) {
+  for (unsigned i = 0; i < count; i++) line[i] = p[i*stride];
+  const unsigned n = 2*radius + 1;
+  for (unsigned i = 0; i < count; i++) {
+    unsigned sum[4] = {0, 0, 0, 0};
+    for (int k = int(i) - int(radius); k <= int(i + radius); k++) {
+      const uint32_t c = line[std::min(std::max(k, 0), int(count) - 1)];
+      for (unsigned ch = 0; ch < 4; ch++) sum[ch] += (c >> (8*ch)) & 0xFF;
+    }
+    uint32_t c = 0;
+    for (unsigned ch = 0; ch < 4; ch++) c |= ((sum[ch] + n/2) / n) << (8*ch);
+    p[i*stride] = c;
+  }
+}
+
+static void referenceBoxBlur(std::vector<uint32_t> &px, unsigned cols, unsigned rows, unsigned radius, bool gaussian) {
+  std::vector<uint32_t> line(std::max(cols, rows));
+  const unsigned passes = gaussian ? 3 : 1;
+  for (unsigned pass = 0; pass < passes; pass++) for (unsigned y = 0; y < rows; y++) referenceBoxLine(&px[y*cols], 1, cols, radius, line);
+  for (unsigned pass = 0; pass < passes; pass++) for (unsigned x = 0; x < cols; x++) referenceBoxLine(&px[x], cols, rows, radius, line);
+}
+
+// largest difference of any channel between the segment and the reference pixels
+static unsigned maxDeviation(const Segment &seg, const std::vector<uint32_t> &ref, unsigned cols, unsigned rows) {
+  unsigned dev = 0;
+  for (unsigned y = 0; y < rows; y++) for (unsigned x = 0; x < cols; x++) {
+    const uint32_t a = seg.getPixelColorXY(x, y), b = ref[y*cols + x];
+    for (unsigned ch = 0; ch < 4; ch++) dev = std::max(dev, (unsigned)abs(int((a >> (8*ch)) & 0xFF) - int((b >> (8*ch)) & 0xFF)));
+  }
+  return dev;
+}
+
+// returns the number of blur settings that deviate from the reference by more than one per pass
+unsigned runBlurBench(unsigned width, unsigned height, unsigned frames, bool csv) {
+  Segment &seg = strip.getMainSegment();
+  seg.setMode(FX_MODE_STATIC, true);
+  strip.service();
+  seg.setDrawDimensions(); // box_blur() and the XY pixel access use the dimensions of the segment being drawn
+  const unsigned cols = seg.vWidth();
+  const unsigned rows = seg.vHeight();
+  std::vector<uint32_t> src(cols * rows), ref;
+  nativeBenchSeedRandom(1);
+  for (uint32_t &c : src) c = hw_random() & 0xFFFFFF; // random RGB, worst case for rounding
+  const auto load = [&]() { for (unsigned y = 0; y < rows; y++) for (unsigned x = 0; x < cols; x++) seg.setPixelColorXY(int(x), int(y), src[y*cols + x]); };
+
+  struct BlurRun { unsigned radius; bool gaussian; };
+  const BlurRun runs[] = { {1, false}, {2, false}, {4, false}, {16, false}, {1, true}, {2, true}, {4, true} };
+
+  if (!csv) {
+    printf("\n2D blur, %ux%u pixels, %u frames\n", width, height, frames);
+    printf("%-16s %10s %10s %10s %8s %8s\n", "blur", "ref us", "box us", "blur2D us", "max dev", "result");
+  }
+  unsigned mismatches = 0;
+  for (const BlurRun &run : runs) {
+    char name[32];
+    snprintf(name, sizeof(name), "%s r=%u", run.gaussian ? "gaussian" : "box", run.radius);
+    ref = src;
+    referenceBoxBlur(ref, cols, rows, run.radius, run.gaussian);
+    load();
+    seg.box_blur(run.radius, run.gaussian);
+    const unsigned dev = maxDeviation(seg, ref, cols, rows);
+    const bool match = dev <= (run.gaussian ? 3U : 1U); // rounding of the running sum: at most one per pass
+    if (!match) mismatches++;
+
+    double refUs = 0, boxUs = 0, carryUs = 0;
+    const uint8_t amount = std::min(255U, 64U * run.radius); // roughly the blur2D() amount setSmearBlur() maps to this radius
+    for (unsigned f = 0; f < frames; f++) {
+      ref = src;
+      auto t0 = std::chrono::steady_clock::now();
+      referenceBoxBlur(ref, cols, rows, run.radius, run.gaussian);
+      auto t1 = std::chrono::steady_clock::now();
+      seg.box_blur(run.radius, run.gaussian);
+      auto t2 = std::chrono::steady_clock::now();
+      seg.blur2D(amount, amount);
+      auto t3 = std::chrono::steady_clock::now();
+      refUs   += std::chrono::duration<double, std::micro>(t1 - t0).count();
+      boxUs   += std::chrono::duration<double, std::micro>(t2 - t1).count();
+      carryUs += std::chrono::duration<double, std::micro>(t3 - t2).count();
+    }
+    if (frames) { refUs /= frames; boxUs /= frames; carryUs /= frames; }
+    if (csv) printf("blur,%ux%u,\"%s\",%.2f,%.2f,%.2f,%u,%s\n", width, height, name, refUs, boxUs, carryUs, dev, match ? "ok" : "MISMATCH");
+    else     printf("%-16s %10.2f %10.2f %10.2f %8u %8s\n", name, refUs, boxUs, carryUs, dev, match ? "ok" : "MISMATCH");
+  }
+  if (!csv) printf("%u of %u blur settings differ from the reference box average\n", mismatches, (unsigned)(sizeof(runs)/sizeof(runs[0])));
+  return mismatches;
+}
@@ -0,0 +1,19 @@
+#pragma once
+/*
+ * Host-native FX benchmark: shared declarations between the core emulation, bus stub and runner
+ */
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef NATIVE_BENCH_HEAP_SIZE
+  #define NATIVE_BENCH_HEAP_SIZE (320*1024) // classic ESP32 without PSRAM: ~320k usable DRAM
+#endif
+
+size_t   nativeBenchHeapUsed();   // bytes allocated since the last nativeBenchHeapReset()
+void     nativeBenchHeapReset();
+void     nativeBenchSeedRandom(uint32_t seed);
+uint32_t nativeBenchBusWrites();  // number of pixels written to the bus stub since the last call
+
+unsigned runBlendBench(unsigned pixels, unsigned frames, bool csv); // blend_bench.cpp, returns number of mismatching runs
+unsigned runNoiseBench(unsigned width, unsigned height, unsigned frames, bool csv); // noise_bench.cpp, returns number of mismatching functions
+unsigned runBlurBench(unsigned width, unsigned height, unsigned frames, bool csv);  // blur_bench.cpp, returns number of blur settings deviating from the reference
@@ -0,0 +1,134 @@
+/*
+ * Bus stub for the host-native FX benchmark
+ * Replaces bus_manager.cpp (which depends on NeoPixelBus), routing and color calculations come from bus_common.cpp
+ * like in the firmware: every configured bus becomes a BusNative that
+ * applies gamma and bus brightness (with look-up tables like BusDigital) and stores the pixel in a 3/4 byte
+ * wire-order buffer, approximating the CPU work of BusDigital::setPixelColors() without any output driver.
+ */
+#include "wled.h"
+#include "native_bench.h"
+
+class BusNative : public Bus {
+  public:
+    BusNative(const BusConfig &bc)
+    : Bus(bc.type, bc.start, bc.autoWhite, bc.count, bc.reversed)
+    , _channels(Bus::hasWhite(bc.type) ? 4 : 3)
+    , _data(static_cast<uint8_t*>(d_calloc(_len, _channels)))
+    {
+      _hasRgb   = hasRGB(bc.type);
+      _hasWhite = hasWhite(bc.type);
+      _hasCCT   = hasCCT(bc.type);
+      _valid    = (_data != nullptr);
+    }
+    ~BusNative() { d_free(_data); }
+
+    void show() override {}
+    void setPixelColor(unsigned pix, uint32_t c) override {
+      if (!_valid || pix >= _len) return;
+      uint8_t ww, cw;
+      if (hasWhite()) c = autoWhiteCalc(c, ww, cw);
+      c = color_fade(c, _bri, true);
+      if (_reversed) pix = _len - pix - 1;
+      uint8_t *p = _data + pix * _channels;
+      p[0] = G(c); p[1] = R(c); p[2] = B(c); // GRB wire order
+      if (_channels > 3) p[3] = W(c);
+      _writes++;
+    }
+    void setPixelColors(unsigned start, const uint32_t *c, size_t len) override {
+      if (!_valid || start >= _len) return;
+      if (start + len > _len) len = _len - start;
+      updateLUT();
+      if (hasWhite()) setPixelSpan<true>(start, c, len); // like BusDigital, stages are selected once per span
+      else            setPixelSpan<false>(start, c, len);
+    }
+    uint32_t getPixelColor(unsigned pix) const override {
+      if (!_valid || pix >= _len) return 0;
+      if (_reversed) pix = _len - pix - 1;
+      const uint8_t *p = _data + pix * _channels;
+      return RGBW32(p[1], p[0], p[2], _channels > 3 ? p[3] : 0);
+    }
+    size_t getBusSize() const override { return sizeof(BusNative) + _len * _channels; }
+
+    static uint32_t _writes;
+
+  private:
+    uint8_t  _channels;
+
+    // gamma tables (R, G, B, W) and brightness table, see BusDigital::updateLUT() (white balance is not emulated)
+    uint8_t  _lut[BUS_LUT_SIZE];
+    float    _lutGamma = -1.0f;
+    uint8_t  _lutBri   = 255;
+
+    void updateLUT() {
+      const float gamma = _gamma ? gammaCorrectVal : 0.0f;
+      if (gamma != _lutGamma) {
+        for (unsigned v = 0; v < 256; v++) _lut[v] = _lut[256 + v] = _lut[512 + v] = _lut[768 + v] = _gamma ? gamma8(v) : v;
+        _lutGamma = gamma;
+      }
+      if (_bri != _lutBri) {
+        for (unsigned v = 0; v < 256; v++) _lut[1024 + v] = (v * _bri + 127) >> 8;
+        _lutBri = _bri;
+      }
+    }
+    inline uint32_t lutFade(uint32_t c) const {
+      if (_lutBri == 255) return c;
+      if (_lutBri == 0)   return 0;
+      const uint8_t *t = _lut + 1024;
+      const uint8_t r = R(c), g = G(c), b = B(c), w = W(c);
+      uint8_t maxc = (r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b);
+      maxc = (maxc>>2) + 1;
+      return RGBW32(t[r] | (r > maxc), t[g] | (g > maxc), t[b] | (b > maxc), t[w] | (w > 0));
+    }
+
+    template<bool hasW> void setPixelSpan(unsigned start, const uint32_t *c, size_t len) {
+      const bool gamma = _gamma;
+      for (size_t i = 0; i < len; i++) {
+        uint32_t col = c[i];
+        uint8_t ww, cw;
+        if (gamma) col = RGBW32(_lut[R(col)], _lut[256 + G(col)], _lut[512 + B(col)], _lut[768 + W(col)]);
+        if (hasW) col = autoWhiteCalc(col, ww, cw);
+        col = lutFade(col);
+        unsigned pix = start + i;
+        if (_reversed) pix = _len - pix - 1;
+        uint8_t *p = _data + pix * _channels;
+        p[0] = G(col); p[1] = R(col); p[2] = B(col); // GRB wire order
+        if (hasW) p[3] = W(col);
+      }
+      _writes += len;
+    }
+    uint8_t *_data;
+};
+
+uint32_t BusNative::_writes = 0;
+
+uint32_t nativeBenchBusWrites() {
+  uint32_t w = BusNative::_writes;
+  BusNative::_writes = 0;
+  return w;
+}
+
+static ColorOrderMap _colorOrderMap = {};
+
+size_t BusConfig::memUsage() const {
+  return (count + skipAmount) * 8 + sizeof(BusNative) + count * Bus::getNumberOfChannels(type);
+}
+
+int BusManager::add(const BusConfig &bc, bool placeholder) {
+  if (placeholder) return -1;
+  busses.push_back(make_unique<BusNative>(bc));
+  rebuildRoutes();
+  return busses.size();
+}
+
+uint8_t BusManager::getI(uint8_t, const uint8_t*, uint8_t) { return 1; } // anything but I_NONE
+void BusManager::removeAll() { busses.clear(); _routes.clear(); _routesOverlap = false; }
+void BusManager::on() {}
+void BusManager::off() {}
+void BusManager::show() { for (auto &bus : busses) bus->show(); }
+bool BusManager::canAllShow() { return true; }
+void BusManager::initializeABL() { _useABL = false; }
+void BusManager::applyABL() {}
+void BusManager::beginABLPrediction() {}                              // ABL is not emulated
+void BusManager::predictCurrent(unsigned, const uint32_t*, size_t) {}
+ColorOrderMap& BusManager::getColorOrderMap() { return _colorOrderMap; }
+String BusManager::getLEDTypesJSONString() { return String(); }
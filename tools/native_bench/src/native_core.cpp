@@ -0,0 +1,66 @@
+/*
+ * Host implementations of the Arduino/ESP-IDF core objects declared in ../include
+ * Heap statistics are reported against a simulated ESP32 heap (NATIVE_BENCH_HEAP_SIZE) using the glibc allocator counters,
+ * so getFreeHeapSize() and friends behave like on a device without PSRAM.
+ */
+#include <Arduino.h>
+#include <WiFi.h>
+#include <LittleFS.h>
+#include <Update.h>
+#include <malloc.h>
+#include <stdarg.h>
+#include "native_bench.h"
+
+std::atomic<uint64_t> nativeBenchMicros{0};
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+fs::FS LittleFS;
+UpdateClass Update;
+const IPAddress INADDR_NONE(0, 0, 0, 0);
+
+static size_t heapBaseline = 0;
+
+size_t nativeBenchHeapUsed() {
+  struct mallinfo2 mi = mallinfo2();
+  return mi.uordblks > heapBaseline ? mi.uordblks - heapBaseline : 0;
+}
+
+void nativeBenchHeapReset() {
+  heapBaseline = 0;
+  heapBaseline = mallinfo2().uordblks;
+}
+
+static size_t simulatedFree() {
+  size_t used = nativeBenchHeapUsed();
+  return used < NATIVE_BENCH_HEAP_SIZE ? NATIVE_BENCH_HEAP_SIZE - used : 0;
+}
+
+uint32_t EspClass::getFreeHeap() { return simulatedFree(); }
+uint32_t EspClass::getHeapSize() { return NATIVE_BENCH_HEAP_SIZE; }
+
+// xorshift32, stands in for the hardware RNG register
+static uint32_t rngState = 0x12345678;
+uint32_t nativeBenchRandomRegister() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+void nativeBenchSeedRandom(uint32_t seed) { rngState = seed ? seed : 0x12345678; }
+
+uint64_t esp_rtc_get_time_us() { return nativeBenchMicros; }
+
+extern "C" {
+void *heap_caps_malloc(size_t size, uint32_t) { return size <= simulatedFree() ? malloc(size) : nullptr; }
+void *heap_caps_calloc(size_t n, size_t size, uint32_t) { return n * size <= simulatedFree() ? calloc(n, size) : nullptr; }
+void *heap_caps_realloc(void *ptr, size_t size, uint32_t) { return size <= simulatedFree() ? realloc(ptr, size) : nullptr; }
+void *heap_caps_malloc_prefer(size_t size, size_t, ...) { return heap_caps_malloc(size, 0); }
+void *heap_caps_calloc_prefer(size_t n, size_t size, size_t, ...) { return heap_caps_calloc(n, size, 0); }
+void *heap_caps_realloc_prefer(void *ptr, size_t size, size_t, ...) { return heap_caps_realloc(ptr, size, 0); }
+void  heap_caps_free(void *ptr) { free(ptr); }
+size_t heap_caps_get_free_size(uint32_t caps) { return (caps & MALLOC_CAP_SPIRAM) ? 0 : simulatedFree(); }
+size_t heap_caps_get_largest_free_block(uint32_t caps) { return heap_caps_get_free_size(caps); }
+size_t heap_caps_get_total_size(uint32_t caps) { return (caps & MALLOC_CAP_SPIRAM) ? 0 : NATIVE_BENCH_HEAP_SIZE; }
+size_t heap_caps_get_minimum_free_size(uint32_t caps) { return heap_caps_get_free_size(caps); }
+}
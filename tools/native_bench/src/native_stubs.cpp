@@ -0,0 +1,15 @@
+/*
+ * Instantiates WLED globals and stubs out the parts of WLED outside the FX engine that it links against
+ * (usermods, E1.31, LED state handling). Nothing here is used by effects for rendering.
+ */
+#define WLED_DEFINE_GLOBAL_VARS
+#include "wled.h"
+
+bool UsermodManager::getUMData(um_data_t **data, uint8_t) { if (data) *data = nullptr; return false; } // audio effects fall back to simulateSound()
+
+void handleE131Packet(e131_packet_t*, IPAddress, byte, size_t) {}
+
+byte scaledBri(byte in) {
+  unsigned val = ((unsigned)in*briMultiplier)/100;
+  return val > 255 ? 255 : val;
+}
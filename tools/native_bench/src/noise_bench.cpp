@@ -0,0 +1,98 @@
+/*
+ * Host-native Perlin noise benchmark
+ * Compares the batch noise functions (perlin8Line(), perlin16Line(), perlin8Tile()) with calling perlin8()/perlin16()
+ * per pixel: checks that both produce identical values and reports the throughput of either in pixels/us.
+ * Then runs the noise based 2D effects on the current matrix and reports pixels/us of one strip.service() call.
+ */
+#include "wled.h"
+#include "native_bench.h"
+#include <chrono>
+#include <functional>
+
+static const char *const noiseEffects[] = { "Noise2D", "Firenoise", "Sun Radiation", "Rotozoomer", "Soap" };
+
+// returns the number of noise functions that did not match the per pixel version
+unsigned runNoiseBench(unsigned width, unsigned height, unsigned frames, bool csv) {
+  if (width == 0)  width  = 1;
+  if (height == 0) height = 1;
+  const unsigned pixels = width * height;
+  std::vector<uint8_t>  ref8(pixels),  out8(pixels);
+  std::vector<uint16_t> ref16(pixels), out16(pixels);
+  const int step8 = 37;      // ~7 samples per lattice cell
+  const int32_t step16 = 5000;
+
+  struct NoiseRun {
+    const char *name;
+    std::function<void(uint32_t)> scalar, batch;
+    bool is8bit;
+  };
+  const NoiseRun runs[] = {
+    { "perlin8 2D row",
+      [&](uint32_t t){ for (unsigned y = 0; y < height; y++) for (unsigned x = 0; x < width; x++) ref8[y*width + x] = perlin8(x*step8, y*step8 + t); },
+      [&](uint32_t t){ for (unsigned y = 0; y < height; y++) perlin8Line(&out8[y*width], width, 0, y*step8 + t, step8, 0); }, true },
+    { "perlin8 2D column",
+      [&](uint32_t t){ for (unsigned x = 0; x < width; x++) for (unsigned y = 0; y < height; y++) ref8[x*height + y] = perlin8(x*step8, y*step8 + t); },
+      [&](uint32_t t){ for (unsigned x = 0; x < width; x++) perlin8Line(&out8[x*height], height, x*step8, t, 0, step8); }, true },
+    { "perlin8 3D tile",
+      [&](uint32_t t){ for (unsigned y = 0; y < height; y++) for (unsigned x = 0; x < width; x++) ref8[y*width + x] = perlin8(x*step8, y*step8, t); },
+      [&](uint32_t t){ perlin8Tile(out8.data(), width, height, 0, 0, t, step8, step8); }, true },
+    { "perlin16 2D row",
+      [&](uint32_t t){ for (unsigned y = 0; y < height; y++) for (unsigned x = 0; x < width; x++) ref16[y*width + x] = perlin16(x*step16, y*step16 + t); },
+      [&](uint32_t t){ for (unsigned y = 0; y < height; y++) perlin16Line(&out16[y*width], width, 0, y*step16 + t, step16, 0); }, false },
+    { "perlin16 3D row",
+      [&](uint32_t t){ for (unsigned y = 0; y < height; y++) for (unsigned x = 0; x < width; x++) ref16[y*width + x] = perlin16(x*step16, y*step16, t); },
+      [&](uint32_t t){ for (unsigned y = 0; y < height; y++) perlin16Line(&out16[y*width], width, 0, y*step16, t, step16, 0, 0); }, false },
+  };
+
+  if (!csv) {
+    printf("\nperlin noise, %ux%u pixels, %u frames\n", width, height, frames);
+    printf("%-20s %12s %12s %8s\n", "function", "scalar px/us", "batch px/us", "result");
+  }
+  unsigned mismatches = 0;
+  for (const NoiseRun &run : runs) {
+    double scalarUs = 0, batchUs = 0;
+    bool match = true;
+    for (unsigned f = 0; f < frames; f++) {
+      const uint32_t t = f * 1000 + 12345;
+      auto t0 = std::chrono::steady_clock::now();
+      run.scalar(t);
+      auto t1 = std::chrono::steady_clock::now();
+      run.batch(t);
+      auto t2 = std::chrono::steady_clock::now();
+      scalarUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+      batchUs  += std::chrono::duration<double, std::micro>(t2 - t1).count();
+      match &= run.is8bit ? (ref8 == out8) : (ref16 == out16);
+    }
+    const double total = double(pixels) * frames;
+    if (!match) mismatches++;
+    if (csv) printf("noise,%ux%u,\"%s\",%.2f,%.2f,%s\n", width, height, run.name, scalarUs > 0 ? total / scalarUs : 0.0, batchUs > 0 ? total / batchUs : 0.0, match ? "ok" : "MISMATCH");
+    else     printf("%-20s %12.2f %12.2f %8s\n", run.name, scalarUs > 0 ? total / scalarUs : 0.0, batchUs > 0 ? total / batchUs : 0.0, match ? "ok" : "MISMATCH");
+  }
+
+  // noise effects, on the main segment of the strip as set up by the caller
+  if (!csv) printf("%-20s %12s\n", "effect", "px/us");
+  Segment &seg = strip.getMainSegment();
+  const unsigned frameTimeUs = 1000000 / WLED_FPS;
+  for (unsigned id = 0; id < strip.getModeCount(); id++) {
+    char name[64];
+    extractModeName(id, nullptr, name, sizeof(name)-1);
+    bool isNoise = false;
+    for (const char *n : noiseEffects) isNoise |= (strcmp(name, n) == 0);
+    if (!isNoise) continue;
+    nativeBenchSeedRandom(id + 1);
+    seg.setMode(id, true);
+    for (unsigned f = 0; f < 10; f++) { nativeBenchAdvance(frameTimeUs); strip.service(); }
+    double sumUs = 0;
+    for (unsigned f = 0; f < frames; f++) {
+      nativeBenchAdvance(frameTimeUs);
+      auto t0 = std::chrono::steady_clock::now();
+      strip.service();
+      sumUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    }
+    const double pxPerUs = sumUs > 0 ? double(strip.getLengthTotal()) * frames / sumUs : 0.0;
+    if (csv) printf("noise_fx,%ux%u,\"%s\",%.2f\n", width, height, name, pxPerUs);
+    else     printf("%-20s %12.2f\n", name, pxPerUs);
+  }
+  if (!csv) printf("%u of %u noise functions differ from the per pixel version\n", mismatches, (unsigned)(sizeof(runs)/sizeof(runs[0])));
+  return mismatches;
+}
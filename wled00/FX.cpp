@@ -5344,16 +5344,16 @@ void mode_2Dfirenoise(void) {               // firenoise2d. By Andrew Tuline. Ye
 
   unsigned xscale = SEGMENT.intensity*4;
   unsigned yscale = SEGMENT.speed*8;
-  unsigned indexx = 0;
+  uint8_t indexx[rows];
 
   CRGBPalette16 pal = SEGMENT.check1 ? SEGPALETTE : CRGBPalette16(CRGB::Black,     CRGB::Black,      CRGB::Black,  CRGB::Black,
                                                                   CRGB::Red,       CRGB::Red,        CRGB::Red,    CRGB::DarkOrange,
                                                                   CRGB::DarkOrange,CRGB::DarkOrange, CRGB::Orange, CRGB::Orange,
                                                                   CRGB::Yellow,    CRGB::Orange,     CRGB::Yellow, CRGB::Yellow);
   for (int j=0; j < cols; j++) {
+    perlin8Line(indexx, rows, j*yscale*rows/255, strip.now/4, 0, xscale);                                       // We're moving along our Perlin map.
     for (int i=0; i < rows; i++) {
-      indexx = perlin8(j*yscale*rows/255, i*xscale+strip.now/4);                                               // We're moving along our Perlin map.
-      SEGMENT.setPixelColorXY(j, i, ColorFromPalette(pal, min(i*indexx/11, 225U), i*255/rows, LINEARBLEND));   // With that value, look up the 8 bit colour palette value and assign it to the current LED.    
+      SEGMENT.setPixelColorXY(j, i, ColorFromPalette(pal, min(i*indexx[i]/11, 225U), i*255/rows, LINEARBLEND)); // With that value, look up the 8 bit colour palette value and assign it to the current LED.
     } // for i
   } // for j
 } // mode_2Dfirenoise()
@@ -5838,11 +5838,12 @@ void mode_2Dnoise(void) {                  // By Andrew Tuline
   const int rows = SEG_H;
 
   const unsigned scale  = SEGMENT.intensity+2;
+  uint8_t pixelHue8[cols];
 
   for (int y = 0; y < rows; y++) {
+    perlin8Line(pixelHue8, cols, 0, y * scale, strip.now / (16 - SEGMENT.speed/16), scale, 0, 0);
     for (int x = 0; x < cols; x++) {
-      uint8_t pixelHue8 = perlin8(x * scale, y * scale, strip.now / (16 - SEGMENT.speed/16));
-      SEGMENT.setPixelColorXY(x, y, ColorFromPalette(SEGPALETTE, pixelHue8));
+      SEGMENT.setPixelColorXY(x, y, ColorFromPalette(SEGPALETTE, pixelHue8[x]));
     }
   }
 } // mode_2Dnoise()
@@ -5967,7 +5968,7 @@ static const char _data_FX_MODE_2DSINDOTS[] PROGMEM = "Sindots@!,Dot distance,Fa
 //////////////////////////////
 //     2D Squared Swirl     //
 //////////////////////////////
-// custom3 affects the blur amount.
+// custom3 affects the blur amount, check1 selects a gaussian blur.
 void mode_2Dsquaredswirl(void) {            // By: Mark Kriegsman. https://gist.github.com/kriegsman/368b316c55221134b160
                                                           // Modifed by: Andrew Tuline
   if (!strip.isMatrix || !SEGMENT.is2D()) FX_FALLBACK_STATIC; // not a 2D set-up
@@ -5978,7 +5979,8 @@ void mode_2Dsquaredswirl(void) {            // By: Mark Kriegsman. https://gist.
   const uint8_t kBorderWidth = 2;
 
   SEGMENT.fadeToBlackBy(1 + SEGMENT.intensity / 5);
-  SEGMENT.blur(SEGMENT.custom3>>1);
+  if (!SEGMENT.check1) SEGMENT.blur(SEGMENT.custom3>>1);
+  else if (SEGMENT.custom3) SEGMENT.box_blur(1 + (SEGMENT.custom3 >> 3), true); // gaussian blur, radius 1-4
 
   // Use two out-of-sync sine waves
   int i = beatsin8_t(19, kBorderWidth, cols-kBorderWidth);
@@ -5992,7 +5994,7 @@ void mode_2Dsquaredswirl(void) {            // By: Mark Kriegsman. https://gist.
   SEGMENT.addPixelColorXY(j, n, ColorFromPalette(SEGPALETTE, strip.now/41, 255, LINEARBLEND));
   SEGMENT.addPixelColorXY(k, p, ColorFromPalette(SEGPALETTE, strip.now/73, 255, LINEARBLEND));
 } // mode_2Dsquaredswirl()
-static const char _data_FX_MODE_2DSQUAREDSWIRL[] PROGMEM = "Squared Swirl@,Fade,,,Blur;;!;2";
+static const char _data_FX_MODE_2DSQUAREDSWIRL[] PROGMEM = "Squared Swirl@,Fade,,,Blur,Gaussian;;!;2";
 
 
 //////////////////////////////
@@ -6012,13 +6014,10 @@ void mode_2DSunradiation(void) {                   // By: ldirko https://editor.
   }
 
   unsigned long t = strip.now / 4;
-  unsigned index = 0;
   uint8_t someVal = SEGMENT.speed/4;             // Was 25.
-  for (int j = 0; j < (rows + 2); j++) {
-    for (int i = 0; i < (cols + 2); i++) {
-      byte col = ((int16_t)perlin8(i * someVal, j * someVal, t) - 127) >> 2; // about +/- 32
-      bump[index++] = col;
-    }
+  perlin8Tile(bump, cols + 2, rows + 2, 0, 0, t, someVal, someVal);
+  for (int index = 0; index < (cols + 2) * (rows + 2); index++) {
+    bump[index] = ((int16_t)bump[index] - 127) >> 2; // about +/- 32
   }
 
   int yindex = cols + 3;
@@ -6613,10 +6612,8 @@ void mode_2Dplasmarotozoom() {
   // plasma
   for (int j = 0; j < rows; j++) {
     int index = j*cols;
-    for (int i = 0; i < cols; i++) {
-      if (SEGMENT.check1) plasma[index+i] = (i * 4 ^ j * 4) + ms / 6;
-      else                plasma[index+i] = inoise8(i * 40, j * 40, ms);
-    }
+    if (!SEGMENT.check1) perlin8Line(plasma + index, cols, 0, j * 40, ms, 40, 0, 0);
+    else for (int i = 0; i < cols; i++) plasma[index+i] = (i * 4 ^ j * 4) + ms / 6;
   }
 
   // rotozoom
@@ -7905,12 +7902,12 @@ void mode_2Dsoap() {
   if (SEGENV.call == 0) for (int i = 0; i < 3; i++) noisecoord[i] = hw_random(); // init
   else                  for (int i = 0; i < 3; i++) noisecoord[i] += mov;
 
-  for (int i = 0; i < cols; i++) {
-    int32_t ioffset = scale32_x * (i - cols / 2);
-    for (int j = 0; j < rows; j++) {
-      int32_t joffset = scale32_y * (j - rows / 2);
-      uint8_t data = perlin16(noisecoord[0] + ioffset, noisecoord[1] + joffset, noisecoord[2]) >> 8;
-      noise3d[XY(i,j)] = scale8(noise3d[XY(i,j)], smoothness) + scale8(data, 255 - smoothness);
+  uint16_t data[cols];
+  for (int j = 0; j < rows; j++) {
+    int32_t joffset = scale32_y * (j - rows / 2);
+    perlin16Line(data, cols, noisecoord[0] + scale32_x * (0 - cols / 2), noisecoord[1] + joffset, noisecoord[2], scale32_x, 0, 0);
+    for (int i = 0; i < cols; i++) {
+      noise3d[XY(i,j)] = scale8(noise3d[XY(i,j)], smoothness) + scale8(data[i] >> 8, 255 - smoothness);
     }
   }
   // init also if dimensions changed
@@ -8310,6 +8307,8 @@ void mode_particlevolcano(void) {
   if (PartSys == nullptr)
     FX_FALLBACK_STATIC; // something went wrong, no data!
 
+  // Particle System settings
+  PartSys->updateSystem(); // update system properties (dimensions and data pointers)
   numSprays = min(PartSys->numSources, (uint32_t)NUMBEROFSOURCES); // number of volcanoes
 
   // change source emitting color from time to time, emit one particle per spray
@@ -8328,8 +8327,6 @@ void mode_particlevolcano(void) {
     }
   }
 
-  // Particle System settings
-  PartSys->updateSystem(); // update system properties (dimensions and data pointers)
   PartSys->setColorByAge(SEGMENT.check1);
   PartSys->setBounceX(SEGMENT.check2);
   PartSys->setWallHardness(SEGMENT.custom2);
@@ -81,6 +81,22 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #endif
 #define FPS_CALC_SHIFT 7 // bit shift for fixed point math
 
+// number of decoded palettes (with interpolation table, 1.1k each) kept for reuse, 0 disables the palette cache
+#ifndef WLED_PALETTE_CACHE_SIZE
+  #ifdef ESP8266
+    #define WLED_PALETTE_CACHE_SIZE 2
+  #else
+    #define WLED_PALETTE_CACHE_SIZE 8
+  #endif
+#endif
+
+// pipelined output (compile with -D WLED_ENABLE_OUTPUT_TASK): a frame is sent to the LEDs by a task on the other core
+// while loop() renders the next one (dual core ESP32 only, needs a second frame buffer)
+#if defined(WLED_ENABLE_OUTPUT_TASK) && defined(ARDUINO_ARCH_ESP32) && !defined(CONFIG_FREERTOS_UNICORE)
+  #define WLED_OUTPUT_TASK
+  #include <atomic>
+#endif
+
 // heap memory limit for effects data, pixel buffers try to reserve it if PSRAM is available
 #ifdef ESP8266
   #define MAX_NUM_SEGMENTS  16
@@ -102,6 +118,14 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
   assuming each segment uses the same amount of data. 256 for ESP8266, 640 for ESP32. */
 #define FAIR_DATA_PER_SEG (MAX_SEGMENT_DATA / MAX_NUM_SEGMENTS)
 
+/* Effect data of all segments is kept in one heap block (arena) that grows in steps of this size
+  and is compacted when segments are reset, instead of one heap allocation per segment and effect change.
+  The arena is released when no segment uses it and shrunk when more than half of it is free. Growing or shrinking
+  allocates the new arena before the old one is freed, so the peak heap use is the sum of both sizes. */
+#ifndef WLED_DATA_ARENA_STEP
+  #define WLED_DATA_ARENA_STEP 1024
+#endif
+
 #define MIN_SHOW_DELAY   (_frametime < 16 ? 8 : 15)
 
 #define NUM_COLORS       3 /* number of colors per segment */
@@ -405,6 +429,8 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #define TRANSITION_PUSH_MASK       0x10
 #define TRANSITION_COUNT           18
 
+#define BLENDMODES  17 // number of segment blend modes, must match "bm" in index.js and WS2812FX::getBlendKernel()
+
 
 typedef enum mapping1D2D {
   M12_Pixels = 0,
@@ -459,6 +485,7 @@ class Segment {
       bool    check3  : 1;        // checkmark 3
     };
     uint8_t   blendMode;          // segment blending modes: top, bottom, add, subtract, difference, average, multiply, divide, lighten, darken, screen, overlay, hardlight, softlight, dodge, burn, stencil
+    uint8_t   fps;                // target effect frame rate, 0 = run effect every strip frame (frames are always composited at strip frame rate)
     char     *name;               // segment name
 
     // runtime data
@@ -470,9 +497,12 @@ class Segment {
 
     static uint16_t maxWidth, maxHeight;  // these define matrix width & height (max. segment dimensions)
 
+    typedef void (*DataRelocator)(byte *data, ptrdiff_t offset); // adjusts pointers into the effect data after it moved by offset bytes
+
   private:
     uint32_t *pixels;                 // pixel data
     unsigned _dataLen;
+    DataRelocator _dataRelocator;     // set by effects that keep pointers into their own data (i.e. particle systems)
     uint8_t  _default_palette;        // palette number that gets assigned to pal0
     union {
       mutable uint8_t _capabilities;  // determines segment capabilities in terms of what is available: RGB, W, CCT, manual W, etc.
@@ -483,15 +513,36 @@ class Segment {
         bool    _manualW  : 1;
       };
     };
+    mutable bool _dirty;              // pixel buffer changed since last blended into frame (set by setPixelColorRaw() & co., cleared in WS2812FX::composeFrame())
+    struct {                          // transition snapshot (old segment) state, see startTransition()
+      bool _frameOnly    : 1;         // snapshot only holds the last rendered frame, its effect is not run
+      bool _sharedPixels : 1;         // pixel buffer is shared with the segment in transition (copy-on-write)
+      bool _sharedData   : 1;         // effect data is shared with the segment in transition (copy-on-write)
+    };
+    uint16_t _cumulativeFps;          // measured effect frame rate (fixed point, see WS2812FX::service())
+    unsigned long _lastRun;           // time of last effect call
 
     // static variables are use to speed up effect calculations by stashing common pre-calculated values
     static unsigned      _usedSegmentData;    // amount of data used by all segments
+    // effect data arena: data buffers of all segments (incl. particle systems) follow each other in one heap block, each
+    // preceded by a header; buffers move when the arena is compacted or grows, so effects must not keep pointers to
+    // SEGENV.data across calls (ParticleSystem::updateSystem() re-reads it every frame), pointers kept inside the data
+    // are adjusted by the segment's DataRelocator (see setDataRelocator())
+    struct DataBlock {
+      Segment *owner;                         // segment whose data pointer points to this block, nullptr if free
+      uint32_t len;                           // payload length (aligned to sizeof(DataBlock))
+    };
+    static byte         *_arena;              // effect data arena (nullptr until first needed)
+    static unsigned      _arenaSize;          // allocated size of the arena
+    static unsigned      _arenaTop;           // end of the last block in the arena
     static unsigned      _vLength;            // 1D dimension used for current effect
     static unsigned      _vWidth, _vHeight;   // 2D dimensions used for current effect
     static uint32_t      _currentColors[NUM_COLORS]; // colors used for current effect (faster access from effect functions)
     static CRGBPalette16 _currentPalette;     // palette used for current effect (includes transition, used in color_from_palette())
     static CRGBPalette16 _randomPalette;      // actual random palette
     static CRGBPalette16 _newRandomPalette;   // target random palette
+    static uint16_t      _randomPaletteGen;   // incremented on every change of _randomPalette
+    static const uint32_t *_currentPaletteLUT; // 256 interpolated colors of _currentPalette or nullptr (used in color_from_palette())
     static uint16_t      _lastPaletteChange;  // last random palette change time (in seconds)
     static uint16_t      _nextPaletteBlend;   // next due time for random palette morph (in millis())
     static bool          _modeBlend;          // mode/effect blending semaphore
@@ -531,15 +582,43 @@ class Segment {
 
     inline static void addUsedSegmentData(int len) { Segment::_usedSegmentData = max(0, int(Segment::_usedSegmentData) + len); }  // clamp negative results to 0
 
-    inline uint32_t *getPixels() const                              { return pixels; }
-    inline void     setPixelColorRaw(unsigned i, uint32_t c) const  { pixels[i] = c; }
+    Segment(const Segment &orig, bool frameOnly);   // transition snapshot (shares buffers with orig)
+
+    inline static bool inArena(const byte *p)        { return _arena && p >= _arena && p < _arena + _arenaSize; }
+    inline static DataBlock *arenaBlock(byte *p)     { return reinterpret_cast<DataBlock*>(p) - 1; }
+    inline void setDataOwner(Segment *owner) const   { if (inArena(data)) arenaBlock(data)->owner = owner; }
+    static byte *arenaAllocate(size_t len, Segment *owner); // returns cleared buffer or nullptr if the arena cannot grow
+    static void  arenaRelease(byte *p);
+    static bool  arenaResize(size_t size);
+    static void  arenaRelocate(byte *dest);         // moves all used blocks to the start of dest (dest may be _arena)
+    static unsigned arenaFree(unsigned *largest);   // returns free bytes in the arena
+    bool unshareBuffers(bool keepContent = true);   // copy-on-write of shared snapshot buffers before they are written to
+    void copyData(const byte *src, DataRelocator relocator); // fills newly allocated data with a copy of src
+
+    inline uint32_t *getPixels() const                              { _dirty = true; return pixels; } // caller may write to the buffer
+    inline void     setPixelColorRaw(unsigned i, uint32_t c) const  { _dirty |= (pixels[i] != c); pixels[i] = c; }
     inline uint32_t getPixelColorRaw(unsigned i) const              { return pixels[i]; };
   #ifndef WLED_DISABLE_2D
-    inline void     setPixelColorXYRaw(unsigned x, unsigned y, uint32_t c) const  { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; pixels[XY(x,y)] = c; }
+    inline void     setPixelColorXYRaw(unsigned x, unsigned y, uint32_t c) const  { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; _dirty |= (pixels[XY(x,y)] != c); pixels[XY(x,y)] = c; }
     inline uint32_t getPixelColorXYRaw(unsigned x, unsigned y) const              { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; return pixels[XY(x,y)]; };
   #endif
     void resetIfRequired();         // sets all SEGENV variables to 0 and clears data buffer
     void loadPalette(CRGBPalette16 &tgt, uint8_t pal);
+    uint8_t resolvePalette(uint8_t pal) const; // ID of the palette loadPalette() will load
+
+    // decoded palettes recently used by any segment, keyed on palette ID, segment colors and random palette generation
+    struct PaletteCacheEntry {
+      CRGBPalette16 palette;
+      uint32_t      colors[3];          // segment colors (palettes 2-5)
+      uint32_t      lastUsed;           // for replacement of least recently used entry
+      uint32_t     *lut;                // palette interpolated to 256 colors (LINEARBLEND, full brightness), allocated when needed
+      uint16_t      generation;         // _randomPaletteGen (palette 1)
+      uint8_t       id;
+      bool          lutValid;
+    };
+    static std::vector<PaletteCacheEntry> _paletteCache;
+    static bool _paletteCacheStale;         // set by clearPaletteCache(), the cache is dropped by beginDraw() on the loop task
+    PaletteCacheEntry *getCachedPalette(uint8_t pal);
 
     // transition functions
     void stopTransition();                  // ends transition mode by destroying transition structure (does nothing if not in transition)
@@ -582,6 +661,7 @@ class Segment {
     , check2(false)
     , check3(false)
     , blendMode(0)
+    , fps(0)
     , name(nullptr)
     , step(0)
     , call(0)
@@ -589,8 +669,15 @@ class Segment {
     , aux1(0)
     , data(nullptr)
     , _dataLen(0)
+    , _dataRelocator(nullptr)
     , _default_palette(6)
     , _capabilities(0)
+    , _dirty(true)
+    , _frameOnly(false)
+    , _sharedPixels(false)
+    , _sharedData(false)
+    , _cumulativeFps(0)
+    , _lastRun(0)
     , _t(nullptr)
     {
       DEBUGFX_PRINTF_P(PSTR("-- Creating segment: %p [%d,%d:%d,%d]\n"), this, (int)start, (int)stop, (int)startY, (int)stopY);
@@ -617,6 +704,8 @@ class Segment {
       #endif
       clearName();
       stopTransition();   // deallocate "_t" (transition) and with it "_segOld" note: _segOld has _t=null, see copy constructor
+      if (_sharedData)   { data = nullptr; _dataLen = 0; } // snapshot does not own buffers it shares with the segment in transition
+      if (_sharedPixels) pixels = nullptr;
       #ifdef WLED_ENABLE_GIF
       endImagePlayback(this);
       #endif
@@ -643,6 +732,7 @@ class Segment {
     inline uint16_t length()               const { return width() * height(); }               // segment length (count) in physical pixels
     inline uint16_t groupLength()          const { return grouping + spacing; }
     inline uint8_t  getLightCapabilities() const { return _capabilities; }
+    inline uint16_t getFps()               const { return (millis() - _lastRun > 2000) ? 0 : (FPS_MULTIPLIER * _cumulativeFps) >> FPS_CALC_SHIFT; } // measured effect frame rate
     inline void     deactivate()                 { setGeometry(0,0); }
     inline Segment &clearName()                  { p_free(name); name = nullptr; return *this; }
     inline Segment &setName(const String &name)  { return setName(name.c_str()); }
@@ -652,6 +742,8 @@ class Segment {
     inline static unsigned vHeight()                       { return Segment::_vHeight; }
     inline static uint32_t getCurrentColor(unsigned i)     { return Segment::_currentColors[i<NUM_COLORS?i:0]; }
     inline static const CRGBPalette16 &getCurrentPalette() { return Segment::_currentPalette; }
+    static void   clearPaletteCache();                    // must be called when custom palettes change (safe from async handlers)
+    static size_t getPaletteCacheSize();                  // memory used by the palette cache
 
     inline void setDrawDimensions() const { Segment::_vWidth = virtualWidth(); Segment::_vHeight = virtualHeight(); Segment::_vLength = virtualLength(); }
 
@@ -670,7 +762,13 @@ class Segment {
     inline uint16_t dataSize() const { return _dataLen; }
     bool allocateData(size_t len);  // allocates effect data buffer in heap and clears it
     void deallocateData();          // deallocates (frees) effect data buffer from heap
+    inline void setDataRelocator(DataRelocator relocator) { _dataRelocator = relocator; } // called whenever data moves or is copied, reset by allocateData()
     inline static unsigned getUsedSegmentData()            { return Segment::_usedSegmentData; }
+    inline static unsigned getDataArenaSize()              { return Segment::_arenaSize; }
+    static unsigned getDataArenaLargestFree();            // largest effect data buffer that fits into the arena without growing it
+    static uint8_t  getDataArenaFragmentation();          // free arena space not part of the largest free block (0-100%)
+    static void     compactData();                        // moves effect data together, done on segment reset
+    static void     trimDataArena();                      // releases or shrinks the arena if most of it is free, done on segment reset
     /**
       * Flags that before the next effect is calculated,
       * the internal segment state should be reset.
@@ -755,7 +853,7 @@ class Segment {
     inline void fadePixelColorXY(uint16_t x, uint16_t y, uint8_t fade) const                   { setPixelColorXY(x, y, color_fade(getPixelColorXY(x,y), fade, true)); }
     inline void blurCols(uint8_t blur_amount, bool smear = false) const                         { blur2D(0, blur_amount, smear); } // blur all columns (50% faster than full 2D blur)
     inline void blurRows(uint8_t blur_amount, bool smear = false) const                         { blur2D(blur_amount, 0, smear); } // blur all rows (50% faster than full 2D blur)
-    //void box_blur(unsigned r = 1U, bool smear = false); // 2D box blur
+    void box_blur(unsigned radius = 1U, bool gaussian = false) const; // separable 2D box blur (gaussian: 3 passes), cost does not depend on radius
     void blur2D(uint8_t blur_x, uint8_t blur_y, bool smear = false) const;
     void moveX(int delta, bool wrap = false) const;
     void moveY(int delta, bool wrap = false) const;
@@ -788,7 +886,7 @@ class Segment {
     inline void addPixelColorXY(int x, int y, byte r, byte g, byte b, byte w = 0, bool preserveCR = true) { addPixelColor(x, RGBW32(r,g,b,w), preserveCR); }
     inline void addPixelColorXY(int x, int y, CRGB c, bool preserveCR = true)         { addPixelColor(x, RGBW32(c.r,c.g,c.b,0), preserveCR); }
     inline void fadePixelColorXY(uint16_t x, uint16_t y, uint8_t fade)            { fadePixelColor(x, fade); }
-    //inline void box_blur(unsigned i, bool vertical, uint8_t blur_amount) {}
+    inline void box_blur(unsigned radius = 1U, bool gaussian = false) {}
     inline void blur2D(uint8_t blur_x, uint8_t blur_y, bool smear = false) {}
     inline void blurRows(uint8_t blur_amount, bool smear = false) {}
     inline void blurCols(uint8_t blur_amount, bool smear = false) {}
@@ -820,6 +918,14 @@ class WS2812FX {
   } mode_data_t;
 
   public:
+    // segment blend mode kernels, selected once per segment by blendSegment()
+    typedef uint32_t (*blend_pixel_ptr)(uint32_t top, uint32_t bottom, uint8_t opacity); // returns the new bottom pixel
+    typedef void     (*blend_run_ptr)(uint32_t *dst, int dstStep, const uint32_t *src, int srcStep, size_t count, uint8_t opacity);
+    struct BlendKernel {
+      blend_pixel_ptr pixel;  // single pixel (slow path)
+      blend_run_ptr   run;    // run of pixels with a constant step in source and destination (fast paths)
+    };
+    static BlendKernel getBlendKernel(uint8_t blendMode); // unsupported modes use "top"
 
     WS2812FX() :
       now(millis()),
@@ -834,7 +940,20 @@ class WS2812FX {
       cctFromRgb(false),
       // true private variables
       _pixels(nullptr),
-      _pixelCCT(nullptr),
+      _cctRebuild(false),
+      _frameAllocs(0),
+      _pixelsOverwritten(false),
+      _redrawAll(true),
+      _frameHash(0),
+      _outputHash(0),
+      _fullOutputFrames(2),
+#ifdef WLED_OUTPUT_TASK
+      _pixelsOut(nullptr),
+      _pixelsOutLen(0),
+      _outputTask(nullptr),
+      _outputBusy(false),
+      _outputGamma(false),
+#endif
       _suspend(false),
       _brightness(DEFAULT_BRIGHTNESS),
       _length(DEFAULT_LED_COUNT),
@@ -862,8 +981,12 @@ class WS2812FX {
     }
 
     ~WS2812FX() {
+#ifdef WLED_OUTPUT_TASK
+      waitForOutput();
+      if (_outputTask) vTaskDelete(_outputTask);
+      p_free(_pixelsOut);
+#endif
       p_free(_pixels);
-      p_free(_pixelCCT); // just in case
       d_free(customMappingTable);
       _mode.clear();
       _modeData.clear();
@@ -895,7 +1018,8 @@ class WS2812FX {
       waitForIt();                                // wait until frame is over (service() has finished or time for 1 frame has passed)
 
     void setRealtimePixelColor(unsigned i, uint32_t c);
-    inline void setPixelColor(unsigned n, uint32_t c) const   { if (n < getLengthTotal()) _pixels[n] = c; }  // paints absolute strip pixel with index n and color c
+    void setRealtimePixelColors(unsigned i, const uint8_t *data, size_t count, unsigned channels); // count LEDs of RGB or RGBW bytes
+    inline void setPixelColor(unsigned n, uint32_t c) const   { if (n < getLengthTotal()) { _pixels[n] = c; _pixelsOverwritten = true; } }  // paints absolute strip pixel with index n and color c
     inline void resetTimebase()                               { timebase = 0UL - millis(); }
     inline void setPixelColor(unsigned n, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0) const
                                                               { setPixelColor(n, RGBW32(r,g,b,w)); }
@@ -917,7 +1041,13 @@ class WS2812FX {
     bool hasCCTBus() const;
     bool deserializeMap(unsigned n = 0);
 
+#ifdef WLED_OUTPUT_TASK
+    inline bool isUpdating() const           { return _outputBusy || !BusManager::canAllShow(); } // return true if the strip is being sent pixel updates
+    void        waitForOutput() const;                                          // waits until the output task has sent its frame, buses may be modified afterwards
+#else
     inline bool isUpdating() const           { return !BusManager::canAllShow(); } // return true if the strip is being sent pixel updates
+    inline void waitForOutput() const        {}
+#endif
     inline bool isServicing() const          { return _isServicing; }           // returns true if strip.service() is executing
     inline bool hasWhiteChannel() const      { return _hasWhiteChannel; }       // returns true if strip contains separate white chanel
     inline bool isOffRefreshRequired() const { return _isOffRefreshRequired; }  // returns true if strip requires regular updates (i.e. TM1814 chipset)
@@ -943,6 +1073,7 @@ class WS2812FX {
     uint16_t getLengthTotal() const; // will include virtual/nonexistent pixels in matrix
 
     inline uint16_t getFps() const          { return (millis() - _lastShow > 2000) ? 0 : (FPS_MULTIPLIER * _cumulativeFps) >> FPS_CALC_SHIFT; } // Returns the refresh rate of the LED strip (_cumulativeFps is stored in fixed point)
+    inline uint32_t getFrameAllocations() const { return _frameAllocs; } // number of buffer (re)allocations made by show(), constant while the setup does not change
     inline uint16_t getFrameTime() const    { return _frametime; }        // returns amount of time a frame should take (in ms)
     inline uint16_t getMinShowDelay() const { return MIN_FRAME_DELAY; }   // returns minimum amount of time strip.service() can be delayed (constant)
     inline uint16_t getLength() const       { return _length; }           // returns actual amount of LEDs on a strip (2D matrix may have less LEDs than W*H)
@@ -1013,9 +1144,42 @@ class WS2812FX {
 
   private:
     uint32_t *_pixels;
-    uint8_t  *_pixelCCT;
     std::vector<Segment> _segments;
 
+    // WLED handles CCT per segment, so each pixel's CCT is that of the last segment blended onto it
+    // it only changes when segments are changed and is kept as sorted runs of pixels covering the whole strip
+    // (empty if no bus needs CCT), it is rebuilt by blendSegment() whenever composeFrame() redraws all segments
+    struct CCTSpan {
+      uint16_t start;
+      uint16_t len;
+      uint8_t  cct;
+    };
+    mutable std::vector<CCTSpan> _cctSpans; // painted by blendSegment()
+    bool     _cctRebuild;               // set while blendSegment() has to paint the CCT of segments
+    uint32_t _frameAllocs;              // heap allocations made by show(), see getFrameAllocations()
+    void     resetCCT(size_t len);
+    void     paintCCT(unsigned from, unsigned to, uint8_t cct) const; // sets CCT of pixels [from,to)
+
+    // dirty region tracking (see composeFrame()): segments are only re-blended if their content or the way they are
+    // blended changed, bus output is only re-encoded for blocks of DIRTY_BLOCK_SIZE pixels changed in this or the previous frame
+    static constexpr unsigned DIRTY_BLOCK_SIZE = 16;
+    mutable bool _pixelsOverwritten;    // _pixels written directly (overlay, realtime), frame needs to be recomposed
+    bool     _redrawAll;                // force full recompose and output (configuration changed)
+    uint32_t _frameHash;                // hash of all parameters that determine how segments are blended
+    uint32_t _outputHash;               // hash of all parameters that determine bus output
+    std::vector<uint32_t> _dirtyBlocks; // bitmap of changed blocks: [current frame | previous frame]
+    std::vector<uint32_t> _outputBlocks; // bitmap of blocks to write to the buses (changed in current or previous frame)
+    uint8_t  _fullOutputFrames;         // number of frames to write in full (output parameters changed or ABL was limiting)
+#ifdef WLED_OUTPUT_TASK
+    uint32_t *_pixelsOut;               // copy of _pixels sent by the output task
+    std::vector<CCTSpan> _cctSpansOut;  // copy of _cctSpans used by the output task
+    size_t   _pixelsOutLen;
+    TaskHandle_t _outputTask;
+    std::atomic<bool> _outputBusy;      // output task owns _pixelsOut, _cctSpansOut and _outputBlocks while set
+    bool     _outputGamma;
+    static void outputTask(void *arg);
+#endif
+
     volatile bool _suspend;
 
     uint8_t  _brightness;
@@ -1049,6 +1213,12 @@ class WS2812FX {
     unsigned long _lastShow;
     unsigned long _lastServiceShow;
 
+    template<typename Sink> void forEachPixelRun(const uint32_t *pixels, const std::vector<CCTSpan> &cctSpans, size_t len, const uint32_t *blocks, Sink sink) const; // see show()
+    void     composeFrame();                           // blends changed segments into _pixels
+    uint32_t frameHash() const;
+    void     markDirty(size_t from, size_t to);        // marks pixels [from,to) as changed in the current frame
+    void     outputFrame(const uint32_t *pixels, const std::vector<CCTSpan> &cctSpans, size_t len, const uint32_t *blocks, bool useGammaCorrection);
+
     friend class Segment;
 };
 
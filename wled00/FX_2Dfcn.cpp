@@ -19,6 +19,8 @@
 // so matrix should disable regular ledmap processing
 // WARNING: effect drawing has to be suspended (strip.suspend()) or must be called from loop() context
 void WS2812FX::setUpMatrix() {
+  waitForOutput();   // output task uses mapping
+  _redrawAll = true; // mapping and dimensions may change
 #ifndef WLED_DISABLE_2D
   // isMatrix is set in cfg.cpp or set.cpp
   if (isMatrix) {
@@ -242,126 +244,90 @@ uint32_t IRAM_ATTR_YN Segment::getPixelColorXY(int x, int y) const {
   return getPixelColorXYRaw(x,y);
 }
 
+// carry blur of count pixels starting at p and spaced by stride: each pixel keeps keep/255 of its color and passes seep/255 to both neighbours
+// the previous pixel is kept in a register until it got its share of the current pixel; returns true if any pixel changed
+static bool carryBlurLine(uint32_t *p, const unsigned stride, const unsigned count, const uint8_t keep, const uint8_t seep) {
+  uint32_t first = p[0];
+  uint32_t carryover = fast_color_scale(first, seep);
+  uint32_t prev = fast_color_scale(first, keep);
+  bool changed = false;
+  for (unsigned i = 1; i < count; i++) {
+    uint32_t *px = p + i*stride;
+    const uint32_t cur = *px;
+    const uint32_t part = fast_color_scale(cur, seep);
+    const uint32_t done = color_add(prev, part); // previous pixel is complete
+    changed |= (px[-(int)stride] != done);
+    px[-(int)stride] = done;
+    prev = color_add(fast_color_scale(cur, keep), carryover);
+    carryover = part;
+  }
+  uint32_t *last = p + (count-1)*stride;
+  changed |= (*last != prev);
+  *last = prev;
+  return changed;
+}
+
 // 2D blurring, can be asymmetrical
 void Segment::blur2D(uint8_t blur_x, uint8_t blur_y, bool smear) const {
   if (!isActive()) return; // not active
   const unsigned cols = vWidth();
   const unsigned rows = vHeight();
-  const auto XY = [&](unsigned x, unsigned y){ return x + y*cols; };
+  bool changed = false;
   if (blur_x) {
     const uint8_t keepx = smear ? 255 : 255 - blur_x;
     const uint8_t seepx = blur_x >> 1;
-    for (unsigned row = 0; row < rows; row++) { // blur rows (x direction)
-      // handle first pixel in row to avoid conditional in loop (faster)
-      uint32_t cur = getPixelColorRaw(XY(0, row));
-      uint32_t carryover = fast_color_scale(cur, seepx);
-      setPixelColorRaw(XY(0, row), fast_color_scale(cur, keepx));
-      for (unsigned x = 1; x < cols; x++) {
-         cur = getPixelColorRaw(XY(x, row));
-        uint32_t part = fast_color_scale(cur, seepx);
-        cur = fast_color_scale(cur, keepx);
-        cur = color_add(cur, carryover);
-        setPixelColorRaw(XY(x - 1, row), color_add(getPixelColorRaw(XY(x-1, row)), part)); // previous pixel
-        setPixelColorRaw(XY(x, row), cur); // current pixel
-        carryover = part;
-      }
-    }
+    for (unsigned row = 0; row < rows; row++) changed |= carryBlurLine(pixels + row*cols, 1, cols, keepx, seepx); // blur rows (x direction)
   }
   if (blur_y) {
     const uint8_t keepy = smear ? 255 : 255 - blur_y;
     const uint8_t seepy = blur_y >> 1;
-    for (unsigned col = 0; col < cols; col++) {
-      // handle first pixel in column
-      uint32_t cur = getPixelColorRaw(XY(col, 0));
-      uint32_t carryover = fast_color_scale(cur, seepy);
-      setPixelColorRaw(XY(col, 0), fast_color_scale(cur, keepy));
-      for (unsigned y = 1; y < rows; y++) {
-        cur = getPixelColorRaw(XY(col, y));
-        uint32_t part = fast_color_scale(cur, seepy);
-        cur = fast_color_scale(cur, keepy);
-        cur = color_add(cur, carryover);
-        setPixelColorRaw(XY(col, y - 1), color_add(getPixelColorRaw(XY(col, y-1)), part)); // previous pixel
-        setPixelColorRaw(XY(col, y), cur); // current pixel
-        carryover = part;
-      }
-    }
+    for (unsigned col = 0; col < cols; col++) changed |= carryBlurLine(pixels + col, cols, rows, keepy, seepy); // blur columns (y direction)
   }
+  _dirty |= changed;
 }
 
-/*
-// 2D Box blur
-void Segment::box_blur(unsigned radius, bool smear) {
+// box blur of count pixels starting at p and spaced by stride, pixels beyond the ends repeat the edge pixels
+// uses a running sum of packed R|B and W|G lanes so the cost per pixel does not depend on the radius (max. 63)
+// line is scratch space for count pixels (the unblurred copy); returns true if any pixel changed
+static bool boxBlurLine(uint32_t *p, const unsigned stride, const unsigned count, const unsigned radius, uint32_t *line) {
+  for (unsigned i = 0; i < count; i++) line[i] = p[i*stride];
+  const unsigned last = count - 1;
+  const uint32_t recip = 65536U / (2*radius + 1); // sum*recip/65536 ~ sum/(2r+1), exact for uniform areas with r <= 63
+  uint32_t rb = 0, wg = 0; // 16 bit lanes: R|B and W|G sums over the 2r+1 pixel window
+  const auto add = [&](uint32_t c) { rb += c & 0x00FF00FF; wg += (c >> 8) & 0x00FF00FF; };
+  const auto sub = [&](uint32_t c) { rb -= c & 0x00FF00FF; wg -= (c >> 8) & 0x00FF00FF; };
+  const auto avg = [&](uint32_t s) { return (s * recip + 0x8000U) >> 16; };
+  for (unsigned i = 0; i <= radius; i++) add(line[0]); // window of first pixel: left half is all edge pixel
+  for (unsigned i = 1; i <= radius; i++) add(line[i < last ? i : last]);
+  bool changed = false;
+  for (unsigned i = 0; i < count; i++) {
+    const uint32_t c = RGBW32(avg(rb >> 16), avg(wg & 0xFFFF), avg(rb & 0xFFFF), avg(wg >> 16));
+    changed |= (p[i*stride] != c);
+    p[i*stride] = c;
+    const unsigned in = i + radius + 1;
+    add(line[in < last ? in : last]);        // slide window: pixel entering on the right
+    sub(line[i > radius ? i - radius : 0]); // pixel leaving on the left
+  }
+  return changed;
+}
+
+// separable 2D box blur with the given radius (1-63) done in place on the pixel buffer
+// gaussian = true does 3 passes per direction which approximates a gaussian blur (sigma ~ sqrt(r*(r+1)))
+void Segment::box_blur(unsigned radius, bool gaussian) const {
   if (!isActive() || radius == 0) return; // not active
-  if (radius > 3) radius = 3;
-  const unsigned d = (1 + 2*radius) * (1 + 2*radius); // averaging divisor
+  if (radius > 63) radius = 63;
   const unsigned cols = vWidth();
   const unsigned rows = vHeight();
-  uint16_t *tmpRSum = new uint16_t[cols*rows];
-  uint16_t *tmpGSum = new uint16_t[cols*rows];
-  uint16_t *tmpBSum = new uint16_t[cols*rows];
-  uint16_t *tmpWSum = new uint16_t[cols*rows];
-  // fill summed-area table (https://en.wikipedia.org/wiki/Summed-area_table)
-  for (unsigned x = 0; x < cols; x++) {
-    unsigned rS, gS, bS, wS;
-    unsigned index;
-    rS = gS = bS = wS = 0;
-    for (unsigned y = 0; y < rows; y++) {
-      index = x * cols + y;
-      if (x > 0) {
-        unsigned index2 = (x - 1) * cols + y;
-        tmpRSum[index] = tmpRSum[index2];
-        tmpGSum[index] = tmpGSum[index2];
-        tmpBSum[index] = tmpBSum[index2];
-        tmpWSum[index] = tmpWSum[index2];
-      } else {
-        tmpRSum[index] = 0;
-        tmpGSum[index] = 0;
-        tmpBSum[index] = 0;
-        tmpWSum[index] = 0;
-      }
-      uint32_t c = getPixelColorXY(x, y);
-      rS += R(c);
-      gS += G(c);
-      bS += B(c);
-      wS += W(c);
-      tmpRSum[index] += rS;
-      tmpGSum[index] += gS;
-      tmpBSum[index] += bS;
-      tmpWSum[index] += wS;
-    }
-  }
-  // do a box blur using pre-calculated sums
-  for (unsigned x = 0; x < cols; x++) {
-    for (unsigned y = 0; y < rows; y++) {
-      // sum = D + A - B - C where k = (x,y)
-      // +----+-+---- (x)
-      // |    | |
-      // +----A-B
-      // |    |k|
-      // +----C-D
-      // |
-      //(y)
-      unsigned x0 = x < radius ? 0 : x - radius;
-      unsigned y0 = y < radius ? 0 : y - radius;
-      unsigned x1 = x >= cols - radius ? cols - 1 : x + radius;
-      unsigned y1 = y >= rows - radius ? rows - 1 : y + radius;
-      unsigned A = x0 * cols + y0;
-      unsigned B = x1 * cols + y0;
-      unsigned C = x0 * cols + y1;
-      unsigned D = x1 * cols + y1;
-      unsigned r = tmpRSum[D] + tmpRSum[A] - tmpRSum[C] - tmpRSum[B];
-      unsigned g = tmpGSum[D] + tmpGSum[A] - tmpGSum[C] - tmpGSum[B];
-      unsigned b = tmpBSum[D] + tmpBSum[A] - tmpBSum[C] - tmpBSum[B];
-      unsigned w = tmpWSum[D] + tmpWSum[A] - tmpWSum[C] - tmpWSum[B];
-      setPixelColorXY(x, y, RGBW32(r/d, g/d, b/d, w/d));
-    }
-  }
-  delete[] tmpRSum;
-  delete[] tmpGSum;
-  delete[] tmpBSum;
-  delete[] tmpWSum;
+  const unsigned passes = gaussian ? 3 : 1;
+  uint32_t line[max(cols, rows)];
+  bool changed = false;
+  if (cols > 1) for (unsigned pass = 0; pass < passes; pass++)
+    for (unsigned row = 0; row < rows; row++) changed |= boxBlurLine(pixels + row*cols, 1, cols, radius, line); // blur rows (x direction)
+  if (rows > 1) for (unsigned pass = 0; pass < passes; pass++)
+    for (unsigned col = 0; col < cols; col++) changed |= boxBlurLine(pixels + col, cols, rows, radius, line); // blur columns (y direction)
+  _dirty |= changed;
 }
-*/
+
 void Segment::moveX(int delta, bool wrap) const {
   if (!isActive() || !delta) return; // not active
   const int vW = vWidth();   // segment width in logical pixels (can be 0 if segment is inactive)
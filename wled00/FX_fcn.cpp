@@ -36,6 +36,9 @@ static_assert(MAX_NUM_SEGMENTS >= WLED_MAX_BUSSES, "Max segments must be at leas
 // Segment class implementation
 ///////////////////////////////////////////////////////////////////////////////
 unsigned      Segment::_usedSegmentData   = 0U; // amount of RAM all segments use for their data[]
+byte         *Segment::_arena             = nullptr;
+unsigned      Segment::_arenaSize         = 0U;
+unsigned      Segment::_arenaTop          = 0U;
 uint16_t      Segment::maxWidth           = DEFAULT_LED_COUNT;
 uint16_t      Segment::maxHeight          = 1;
 unsigned      Segment::_vLength           = 0;
@@ -45,6 +48,10 @@ uint32_t      Segment::_currentColors[NUM_COLORS] = {0,0,0};
 CRGBPalette16 Segment::_currentPalette    = CRGBPalette16();
 CRGBPalette16 Segment::_randomPalette     = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
 CRGBPalette16 Segment::_newRandomPalette  = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
+uint16_t      Segment::_randomPaletteGen  = 0;
+const uint32_t *Segment::_currentPaletteLUT = nullptr;
+std::vector<Segment::PaletteCacheEntry> Segment::_paletteCache;
+bool Segment::_paletteCacheStale = false;
 uint16_t      Segment::_lastPaletteChange = 0; // in seconds; perhaps it should be per segment
 uint16_t      Segment::_nextPaletteBlend  = 0; // in millis
 
@@ -63,6 +70,7 @@ Segment::Segment(const Segment &orig) {
   data = nullptr;
   _dataLen = 0;
   pixels = nullptr;
+  _frameOnly = _sharedPixels = _sharedData = false;
   if (!stop) return;  // nothing to do if segment is inactive/invalid
   if (orig.pixels) {
     // allocate pixel buffer: prefer IRAM/PSRAM
@@ -70,7 +78,7 @@ Segment::Segment(const Segment &orig) {
     if (pixels) {
       memcpy(pixels, orig.pixels, sizeof(uint32_t) * orig.length());
       if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM)); if (name) strcpy(name, orig.name); }
-      if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
+      if (orig.data) { if (allocateData(orig._dataLen)) copyData(orig.data, orig._dataRelocator); }
     } else {
       DEBUGFX_PRINTLN(F("!!! Not enough RAM for pixel buffer !!!"));
       errorFlag = ERR_NORAM_PX;
@@ -79,10 +87,30 @@ Segment::Segment(const Segment &orig) {
   } else stop = 0; // mark segment as inactive/invalid
 }
 
+// transition snapshot: a copy that shares the pixel buffer (and effect data unless only the last frame is kept)
+// with the original instead of duplicating them, a buffer is only copied once either side writes to it (see unshareBuffers())
+Segment::Segment(const Segment &orig, bool frameOnly) {
+  //DEBUG_PRINTF_P(PSTR("-- Snapshot segment constructor: %p -> %p\n"), &orig, this);
+  memcpy((void*)this, (void*)&orig, sizeof(Segment));
+  _t   = nullptr; // snapshot cannot be in transition
+  name = nullptr;
+  _frameOnly    = frameOnly;
+  _sharedPixels = (pixels != nullptr);
+  _sharedData   = (data != nullptr) && !frameOnly;
+  if (!_sharedData) {
+    data = nullptr;
+    _dataLen = 0;
+    _dataRelocator = nullptr;
+  }
+  if (!pixels) stop = 0; // mark segment as inactive/invalid
+  else if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM)); if (name) strcpy(name, orig.name); }
+}
+
 // move constructor
 Segment::Segment(Segment &&orig) noexcept {
   //DEBUG_PRINTF_P(PSTR("-- Move segment constructor: %p -> %p\n"), &orig, this);
   memcpy((void*)this, (void*)&orig, sizeof(Segment));
+  setDataOwner(this);
   orig._t   = nullptr; // old segment cannot be in transition any more
   orig.name = nullptr;
   orig.data = nullptr;
@@ -105,6 +133,7 @@ Segment& Segment::operator= (const Segment &orig) {
     // erase pointers to allocated data
     data = nullptr;
     _dataLen = 0;
+    _frameOnly = _sharedPixels = _sharedData = false;
     if (!stop) return *this;  // nothing to do if segment is inactive/invalid
     // copy source data
     if (orig.pixels) {
@@ -113,7 +142,7 @@ Segment& Segment::operator= (const Segment &orig) {
       if (pixels) {
         memcpy(pixels, orig.pixels, sizeof(uint32_t) * orig.length());
         if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM)); if (name) strcpy(name, orig.name); }
-        if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
+        if (orig.data) { if (allocateData(orig._dataLen)) copyData(orig.data, orig._dataRelocator); }
       } else {
         DEBUG_PRINTLN(F("!!! Not enough RAM for pixel buffer !!!"));
         errorFlag = ERR_NORAM_PX;
@@ -134,6 +163,7 @@ Segment& Segment::operator= (Segment &&orig) noexcept {
     p_free(pixels);   // free old pixel buffer
     // move source data
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
+    setDataOwner(this);
     orig.name = nullptr;
     orig.data = nullptr;
     orig._dataLen = 0;
@@ -151,6 +181,7 @@ bool Segment::allocateData(size_t len) {
       if (_dataLen < FAIR_DATA_PER_SEG) { // segment data is small
         //DEBUG_PRINTF_P(PSTR("--   Clearing data (%d): %p\n"), len, this);
         memset(data, 0, len);  // erase buffer if called during effect initialisation
+        _dataRelocator = nullptr;
         return true; // no need to reallocate
       }
     }
@@ -168,13 +199,12 @@ bool Segment::allocateData(size_t len) {
   }
   #endif
 
-  if (data) {
-    d_free(data); // free data and try to allocate again (segment buffer may be blocking contiguous heap)
-    Segment::addUsedSegmentData(-_dataLen); // subtract buffer size
-  }
+  if (data) deallocateData(); // free data and try to allocate again (segment buffer may be blocking contiguous heap)
 
-  data = static_cast<byte*>(allocate_buffer(len, BFRALLOC_PREFER_DRAM | BFRALLOC_CLEAR)); // prefer DRAM over PSRAM for speed
+  data = arenaAllocate(len, this);
+  if (!data) data = static_cast<byte*>(allocate_buffer(len, BFRALLOC_PREFER_DRAM | BFRALLOC_CLEAR)); // arena cannot grow: prefer DRAM over PSRAM for speed
 
+  _dataRelocator = nullptr; // new content
   if (data) {
     Segment::addUsedSegmentData(len);
     _dataLen = len;
@@ -189,7 +219,18 @@ bool Segment::allocateData(size_t len) {
 
 void Segment::deallocateData() {
   if (!data) { _dataLen = 0; return; }
-  if ((Segment::getUsedSegmentData() > 0) && (_dataLen > 0)) { // check that we don't have a dangling / inconsistent data pointer
+  Segment *old = getOldSegment();
+  if (old && old->_sharedData) { // transition snapshot takes over the buffer
+    old->_sharedData = false;
+    setDataOwner(old);
+    data = nullptr;
+    _dataLen = 0;
+    _dataRelocator = nullptr;
+    return;
+  }
+  if (inArena(data)) {
+    arenaRelease(data); // arena block must not keep pointing to this segment
+  } else if ((Segment::getUsedSegmentData() > 0) && (_dataLen > 0)) { // check that we don't have a dangling / inconsistent data pointer
     //DEBUG_PRINTF_P(PSTR("---  Released data (%p): %d/%d -> %p\n"), this, _dataLen, Segment::getUsedSegmentData(), data);
     d_free(data);
   } else {
@@ -198,6 +239,142 @@ void Segment::deallocateData() {
   data = nullptr;
   Segment::addUsedSegmentData(_dataLen <= Segment::getUsedSegmentData() ? -_dataLen : -Segment::getUsedSegmentData());
   _dataLen = 0;
+  _dataRelocator = nullptr;
+}
+
+// copies _dataLen bytes from src into data (just allocated) and lets the effect adjust pointers into its data
+void Segment::copyData(const byte *src, DataRelocator relocator) {
+  memcpy(data, src, _dataLen);
+  _dataRelocator = relocator;
+  if (relocator) relocator(data, data - src);
+}
+
+// takes a block for len bytes from the arena: first fit into a free block, otherwise appended after the last block
+// (compacting and/or growing the arena if needed, which moves the data of other segments)
+byte *Segment::arenaAllocate(size_t len, Segment *owner) {
+  const unsigned size = (len + sizeof(DataBlock) - 1) & ~(sizeof(DataBlock) - 1);
+  const unsigned need = sizeof(DataBlock) + size;
+  DataBlock *b = nullptr;
+  for (unsigned pos = 0; pos < _arenaTop; pos += sizeof(DataBlock) + b->len) {
+    b = reinterpret_cast<DataBlock*>(_arena + pos);
+    if (b->owner || b->len < size) continue;
+    if (b->len >= need) { // split off the remainder as a new free block
+      DataBlock *rest = reinterpret_cast<DataBlock*>(_arena + pos + need);
+      rest->owner = nullptr;
+      rest->len   = b->len - need;
+      b->len = size;
+    }
+    b->owner = owner;
+    memset(b + 1, 0, b->len);
+    return reinterpret_cast<byte*>(b + 1);
+  }
+  if (_arenaSize - _arenaTop < need) {
+    compactData();
+    if (_arenaSize - _arenaTop < need && !arenaResize(_arenaTop + need)) return nullptr;
+  }
+  b = reinterpret_cast<DataBlock*>(_arena + _arenaTop);
+  b->owner = owner;
+  b->len   = size;
+  _arenaTop += need;
+  memset(b + 1, 0, size);
+  return reinterpret_cast<byte*>(b + 1);
+}
+
+// marks a block free, merges adjacent free blocks and drops free blocks at the end
+void Segment::arenaRelease(byte *p) {
+  arenaBlock(p)->owner = nullptr;
+  DataBlock *prevFree = nullptr;
+  unsigned top = 0;
+  for (unsigned pos = 0; pos < _arenaTop; ) {
+    DataBlock *b = reinterpret_cast<DataBlock*>(_arena + pos);
+    pos += sizeof(DataBlock) + b->len;
+    if (b->owner)      { prevFree = nullptr; top = pos; }
+    else if (prevFree) prevFree->len += sizeof(DataBlock) + b->len;
+    else               prevFree = b;
+  }
+  _arenaTop = top;
+}
+
+// replaces the arena with one of the given size (rounded up to WLED_DATA_ARENA_STEP, must hold _arenaTop bytes),
+// old and new arena are both allocated while used blocks are copied over
+bool Segment::arenaResize(size_t size) {
+  size = (size + WLED_DATA_ARENA_STEP - 1) / WLED_DATA_ARENA_STEP * WLED_DATA_ARENA_STEP;
+  byte *arena = static_cast<byte*>(allocate_buffer(size, BFRALLOC_PREFER_DRAM)); // prefer DRAM over PSRAM for speed
+  if (!arena) {
+    DEBUGFX_PRINTF_P(PSTR("!!! Segment data arena cannot be resized to %u !!!\n"), (unsigned)size);
+    return false;
+  }
+  if (_arena) {
+    arenaRelocate(arena);
+    d_free(_arena);
+  }
+  _arena     = arena;
+  _arenaSize = size;
+  return true;
+}
+
+void Segment::arenaRelocate(byte *dest) {
+  unsigned top = 0;
+  for (unsigned pos = 0; pos < _arenaTop; ) {
+    DataBlock *b = reinterpret_cast<DataBlock*>(_arena + pos);
+    const unsigned blockLen = sizeof(DataBlock) + b->len;
+    pos += blockLen;
+    if (!b->owner) continue;
+    if (dest + top != reinterpret_cast<byte*>(b)) {
+      Segment *owner = b->owner;
+      byte *moved = dest + top + sizeof(DataBlock);
+      const ptrdiff_t offset = moved - owner->data;
+      Segment *old = owner->getOldSegment();
+      if (old && old->_sharedData && old->data == owner->data) old->data = moved; // transition snapshot shares the buffer
+      owner->data = moved;
+      memmove(dest + top, b, blockLen);
+      if (owner->_dataRelocator) owner->_dataRelocator(moved, offset); // i.e. particle system pointers
+    }
+    top += blockLen;
+  }
+  _arenaTop = top;
+}
+
+unsigned Segment::arenaFree(unsigned *largest) {
+  unsigned total = _arenaSize - _arenaTop;
+  *largest = total;
+  for (unsigned pos = 0; pos < _arenaTop; ) {
+    const DataBlock *b = reinterpret_cast<const DataBlock*>(_arena + pos);
+    pos += sizeof(DataBlock) + b->len;
+    if (b->owner) continue;
+    total += b->len;
+    if (b->len > *largest) *largest = b->len;
+  }
+  return total;
+}
+
+unsigned Segment::getDataArenaLargestFree() {
+  unsigned largest;
+  arenaFree(&largest);
+  return largest;
+}
+
+uint8_t Segment::getDataArenaFragmentation() {
+  unsigned largest;
+  unsigned total = arenaFree(&largest);
+  return total ? 100 - (100 * largest) / total : 0;
+}
+
+void Segment::compactData() {
+  if (_arena) arenaRelocate(_arena);
+}
+
+// gives unused arena space back to the heap: releases the arena if no segment uses it, shrinks it if more than
+// half of it is free (call after compactData() so that all free space is at the end)
+void Segment::trimDataArena() {
+  if (!_arena) return;
+  if (_arenaTop == 0) {
+    d_free(_arena);
+    _arena     = nullptr;
+    _arenaSize = 0;
+  } else if (_arenaTop + WLED_DATA_ARENA_STEP <= _arenaSize / 2) {
+    arenaResize(_arenaTop); // keeps the old arena if the smaller one cannot be allocated
+  }
 }
 
 /**
@@ -210,12 +387,16 @@ void Segment::deallocateData() {
 void Segment::resetIfRequired() {
   if (!reset || !isActive()) return;
   //DEBUG_PRINTF_P(PSTR("-- Segment reset: %p\n"), this);
+  unshareBuffers(false); // buffers are cleared, a transition snapshot keeps the old content
   if (data && _dataLen > 0) {
     if (_dataLen > FAIR_DATA_PER_SEG) deallocateData(); // do not keep large allocations
     else memset(data, 0, _dataLen);  // can prevent heap fragmentation
     DEBUG_PRINTF_P(PSTR("-- Segment %p reset, data cleared\n"), this);
   }
+  compactData();   // close the gaps left by released effect data
+  trimDataArena(); // and return the space freed by large allocations to the heap
   if (pixels) for (size_t i = 0; i < length(); i++) pixels[i] = BLACK; // clear pixel buffer
+  _dirty = true;
   step = 0; call = 0; aux0 = 0; aux1 = 0;
   reset = false;
   #ifdef WLED_ENABLE_GIF
@@ -223,12 +404,7 @@ void Segment::resetIfRequired() {
   #endif
 }
 
-void Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
-  // there is one randomly generated palette (1) followed by 4 palettes created from segment colors (2-5)
-  // those are followed by 7 fastled palettes (6-12) and 59 gradient palettes (13-71)
-  // then come user custom palettes (IDs <=200) and usermod palettes (IDs 201-255), both growing downward from their respective base IDs
-  // palette 0 is a varying palette depending on effect and may be replaced by segment's color if so
-  // instructed in color_from_palette()
+uint8_t Segment::resolvePalette(uint8_t pal) const {
   if (pal == 0) pal = _default_palette; // _default_palette is set in setMode(), differs depending on effect
   const int umCount   = usermodPalettes.size();
   const int custCount = customPalettes.size();
@@ -239,6 +415,16 @@ void Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
       if ((WLED_CUSTOM_PALETTE_ID_BASE - pal) >= custCount) pal = 0;
     }
   }
+  return pal;
+}
+
+void Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
+  // there is one randomly generated palette (1) followed by 4 palettes created from segment colors (2-5)
+  // those are followed by 7 fastled palettes (6-12) and 59 gradient palettes (13-71)
+  // then come user custom palettes (IDs <=200) and usermod palettes (IDs 201-255), both growing downward from their respective base IDs
+  // palette 0 is a varying palette depending on effect and may be replaced by segment's color if so
+  // instructed in color_from_palette()
+  pal = resolvePalette(pal);
   switch (pal) {
     case 0: //default palette. Exceptions for specific effects above
       targetPalette = PartyColors_gc22;
@@ -287,9 +473,56 @@ void Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
   }
 }
 
+// returns the decoded palette from the cache, loading it into the least recently used entry if it is not there
+// usermod palettes are not cached as they may be changed at any time (i.e. by audio reactive)
+Segment::PaletteCacheEntry *Segment::getCachedPalette(uint8_t pal) {
+  if (WLED_PALETTE_CACHE_SIZE == 0) return nullptr;
+  pal = resolvePalette(pal);
+  if (pal > WLED_CUSTOM_PALETTE_ID_BASE) return nullptr;
+  static uint32_t useCount = 0;
+  useCount++;
+  const bool usesColors = (pal >= 2 && pal <= 5);
+  const uint16_t generation = (pal == 1) ? _randomPaletteGen : 0;
+  PaletteCacheEntry *entry = nullptr;
+  for (PaletteCacheEntry &e : _paletteCache) {
+    if (e.id == pal && e.generation == generation && (!usesColors || memcmp(e.colors, colors, sizeof(e.colors)) == 0)) {
+      e.lastUsed = useCount;
+      return &e;
+    }
+    if (!entry || e.lastUsed < entry->lastUsed) entry = &e;
+  }
+  if (_paletteCache.size() < WLED_PALETTE_CACHE_SIZE) {
+    _paletteCache.reserve(WLED_PALETTE_CACHE_SIZE); // entries must not move
+    _paletteCache.emplace_back();
+    entry = &_paletteCache.back();
+    entry->lut = nullptr;
+  }
+  entry->id = pal;
+  entry->generation = generation;
+  memcpy(entry->colors, colors, sizeof(entry->colors));
+  entry->lastUsed = useCount;
+  entry->lutValid = false;
+  loadPalette(entry->palette, pal);
+  return entry;
+}
+
+// custom palettes are reloaded from async web handlers while a frame may be drawn from the cache,
+// so the cache is only marked here and dropped by the next beginDraw()
+void Segment::clearPaletteCache() {
+  _paletteCacheStale = true;
+}
+
+size_t Segment::getPaletteCacheSize() {
+  size_t size = _paletteCache.capacity() * sizeof(PaletteCacheEntry);
+  for (const PaletteCacheEntry &e : _paletteCache) if (e.lut) size += 256 * sizeof(uint32_t);
+  return size;
+}
+
 // starting a transition has to occur before change so we get current values 1st
 // note: _t is the temporary segment that holds the values transitioned from (palette, colors, brightness,...) and the current segment holds the "to" values
-//       if this is a non FADE transition or an FX change, the _oldSegment is created which is a full copy of the segment before the change
+//       if this is a non FADE transition or an FX change, the _oldSegment is created which is a snapshot of the segment before the change
+//       the snapshot shares pixel buffer and effect data with the segment until one of them draws (copy-on-write, see unshareBuffers())
+//       for FADE the snapshot keeps only the last rendered frame and its effect is not run, so no effect data is needed
 void Segment::startTransition(uint16_t dur, bool segmentCopy) {
   if (dur == 0 || !isActive()) {
     if (isInTransition()) _t->_dur = 0;
@@ -298,7 +531,7 @@ void Segment::startTransition(uint16_t dur, bool segmentCopy) {
   if (isInTransition()) {
     if (segmentCopy && !_t->_oldSegment) {
       // already in transition but segment copy requested and not yet created
-      _t->_oldSegment = new(std::nothrow) Segment(*this); // store/copy current segment settings
+      _t->_oldSegment = new(std::nothrow) Segment(*this, blendingStyle == TRANSITION_FADE); // store current segment settings (snapshot)
       _t->_start = millis(); // restart transition timer
       _t->_dur   = dur;
       _t->_prevPaletteBlends = 0; // reset palette blends
@@ -347,7 +580,7 @@ void Segment::startTransition(uint16_t dur, bool segmentCopy) {
     _t->_palette = palette;
     loadPalette(_t->_palT, palette);
     for (int i=0; i<NUM_COLORS; i++) _t->_colors[i] = colors[i];
-    if (segmentCopy) _t->_oldSegment = new(std::nothrow) Segment(*this); // store/copy current segment settings
+    if (segmentCopy) _t->_oldSegment = new(std::nothrow) Segment(*this, blendingStyle == TRANSITION_FADE); // store current segment settings (snapshot)
     if (_t->_oldSegment) {
       DEBUGFX_PRINTF_P(PSTR("-- Started transition: S=%p T(%p) O[%p] OP[%p]\n"), this, _t, _t->_oldSegment, _t->_oldSegment->pixels);
       if (!_t->_oldSegment->isActive()) stopTransition();
@@ -357,6 +590,68 @@ void Segment::startTransition(uint16_t dur, bool segmentCopy) {
   };
 }
 
+// copy-on-write of transition snapshot buffers, must be called before shared buffers are written to
+// the snapshot copies the buffers it shares, the segment in transition hands its buffers over to the snapshot and
+// continues with new ones (keepContent=false if they will be cleared anyway, i.e. on reset)
+// if there is not enough memory the snapshot's effect is not run (returns false) or the transition is stopped
+bool Segment::unshareBuffers(bool keepContent) {
+  const size_t pxSize = length() * sizeof(uint32_t);
+  if (_sharedPixels || _sharedData) {
+    if (_sharedPixels) {
+      uint32_t *px = static_cast<uint32_t*>(allocate_buffer(pxSize, BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
+      if (!px) return false;
+      memcpy(px, pixels, pxSize);
+      pixels = px;
+      _sharedPixels = false;
+    }
+    if (_sharedData) {
+      const Segment *src = inArena(data) ? arenaBlock(data)->owner : nullptr; // shared buffer may move in the arena while allocating
+      const byte *shared = data;
+      const unsigned len = _dataLen;
+      const DataRelocator relocator = _dataRelocator;
+      data = nullptr;
+      _dataLen = 0;
+      _sharedData = false;
+      if (!allocateData(len)) return false;
+      copyData(src ? src->data : shared, relocator);
+    }
+    return true;
+  }
+  Segment *old = getOldSegment();
+  if (!old) return true;
+  if (old->_sharedData) {
+    const unsigned len = _dataLen;
+    old->_sharedData = false;
+    setDataOwner(old);
+    data = nullptr;
+    _dataLen = 0;
+    if (keepContent) {
+      if (!allocateData(len)) { // take the buffer back
+        data = old->data;
+        _dataLen = len;
+        _dataRelocator = old->_dataRelocator;
+        old->_sharedData = true;
+        setDataOwner(this);
+        stopTransition();
+        return true;
+      }
+      copyData(old->data, old->_dataRelocator);
+    }
+  }
+  if (old->_sharedPixels) {
+    uint32_t *px = static_cast<uint32_t*>(allocate_buffer(pxSize, BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS | (keepContent ? 0 : BFRALLOC_CLEAR)));
+    if (!px) {
+      DEBUGFX_PRINTLN(F("!!! Not enough RAM for transition pixel buffer !!!"));
+      stopTransition();
+      return true;
+    }
+    if (keepContent) memcpy(px, pixels, pxSize);
+    pixels = px;
+    old->_sharedPixels = false;
+  }
+  return true;
+}
+
 void Segment::stopTransition() {
   if (_t == nullptr) return; // no ongoing transition
   DEBUG_PRINTF_P(PSTR("-- Stopping transition: S=%p T(%p) O[%p]\n"), this, _t, _t->_oldSegment);
@@ -404,9 +699,29 @@ void Segment::beginDraw(uint16_t prog) {
   setDrawDimensions();
   // load colors into _currentColors
   for (unsigned i = 0; i < NUM_COLORS; i++) _currentColors[i] = colors[i];
-  // load palette into _currentPalette
-  loadPalette(Segment::_currentPalette, palette);
+  // load palette into _currentPalette, together with its interpolation table if the palette is interpolated
+  _currentPaletteLUT = nullptr;
+  if (_paletteCacheStale) {
+    _paletteCacheStale = false;
+    for (PaletteCacheEntry &e : _paletteCache) d_free(e.lut);
+    _paletteCache.clear();
+  }
+  PaletteCacheEntry *cached = getCachedPalette(palette);
+  if (cached) {
+    Segment::_currentPalette = cached->palette;
+    if (paletteBlend != 3) {
+      if (!cached->lut) cached->lut = static_cast<uint32_t*>(d_malloc(256 * sizeof(uint32_t)));
+      if (cached->lut && !cached->lutValid) {
+        for (unsigned i = 0; i < 256; i++) cached->lut[i] = ColorFromPalette(cached->palette, i, 255, LINEARBLEND);
+        cached->lutValid = true;
+      }
+      _currentPaletteLUT = cached->lut;
+    }
+  } else {
+    loadPalette(Segment::_currentPalette, palette);
+  }
   if (isInTransition() && prog < 0xFFFFU && blendingStyle == TRANSITION_FADE) {
+    _currentPaletteLUT = nullptr; // palette is blended in every frame
     // blend colors
     for (unsigned i = 0; i < NUM_COLORS; i++) _currentColors[i] = color_blend16(_t->_colors[i], colors[i], prog);
     // blend palettes
@@ -439,6 +754,7 @@ void Segment::handleRandomPalette() {
   unsigned transitionFrames = frameTime > transitionTime ? 1 : transitionTime / frameTime; // i.e. 700ms/23ms = 30 or 20000ms/8ms = 2500 or 100ms/1000ms = 0 -> 1
   unsigned noOfBlends = transitionFrames > 255 ? 1 : (255 + (transitionFrames>>1)) / transitionFrames;  // we do some rounding here
   for (unsigned i = 0; i < noOfBlends; i++) nblendPaletteTowardPalette(Segment::_randomPalette, Segment::_newRandomPalette, 48);
+  Segment::_randomPaletteGen++;
   Segment::_nextPaletteBlend = now + ((transitionFrames >> 8) * frameTime); // postpone next blend if necessary
 }
 
@@ -1168,10 +1484,18 @@ uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool moving, uint
     case 1: blend = LINEARBLEND; break;
     case 2: blend = LINEARBLEND_NOWRAP; break;
   }
-  CRGBW palcol = ColorFromPalette(_currentPalette, paletteIndex, pbri, blend);
-  palcol.w = W(color);
-
-  return palcol.color32;
+  uint32_t palcol;
+  if (_currentPaletteLUT && blend != NOBLEND) {
+    if (blend == LINEARBLEND_NOWRAP) paletteIndex = (paletteIndex * 0xF0) >> 8; // same remapping as ColorFromPalette()
+    palcol = _currentPaletteLUT[paletteIndex & 0xFF];
+    if (pbri < 255) { // same as in ColorFromPalette(), LUT has no white
+      const uint32_t scale = pbri + 1;
+      palcol = ((((palcol & 0x00FF00FF) * scale) >> 8) & 0x00FF00FF) | ((((palcol & 0x0000FF00) * scale) >> 8) & 0x0000FF00);
+    }
+  } else {
+    palcol = ColorFromPalette(_currentPalette, paletteIndex, pbri, blend);
+  }
+  return palcol | (color & 0xFF000000); // white from segment color
 }
 
 
@@ -1191,6 +1515,7 @@ void WS2812FX::finalizeInit() {
   enumerateLedmaps();
 
   _hasWhiteChannel = _isOffRefreshRequired = false;
+  waitForOutput(); // buses are in use by output task
   BusManager::removeAll();
   // TODO: ideally we would free everything segment related here to reduce fragmentation (pixel buffers, ledamp, segments, etc) but that somehow leads to heap corruption if touchig any of the buffers.
   unsigned digitalCount = 0;
@@ -1297,9 +1622,11 @@ void WS2812FX::finalizeInit() {
 // update global _pixels[] buffer to match getLengthTotal() note: if allocation fails, WLED will not render anything
 void WS2812FX::updatePixelBuffer() {
   uint32_t requiredMem = getLengthTotal() * sizeof(uint32_t);
+  waitForOutput(); // output task may still read mapping and length
   p_free(_pixels); // using realloc on large buffers can cause additional fragmentation instead of reducing it
   // use PSRAM if available: there is no measurable perfomance impact between PSRAM and DRAM on S2/S3 with QSPI PSRAM for this buffer
   _pixels = static_cast<uint32_t*>(allocate_buffer(requiredMem, BFRALLOC_ENFORCE_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR));
+  _redrawAll = true; // new buffer needs all segments
   DEBUG_PRINTF_P(PSTR("strip buffer size: %uB\n"), requiredMem);
 }
 
@@ -1329,8 +1656,17 @@ void WS2812FX::service() {
       // current segment is active -> re-run effect, and remember that show() call is necessary
       // if we arrive here, its always showtime (timeToShow == true)
       doShow = true;
-      if (!seg.freeze) { //only run effect function if not frozen
+      // segment with its own frame rate: only run effect when due (within half a strip frame), frame is composited anyway
+      const unsigned segFrameTime = seg.fps ? 1000U / seg.fps : 0;
+      const bool due = _triggered || seg.call == 0 || nowUp - seg._lastRun + _frametime/2 >= segFrameTime;
+      if (!seg.freeze && due) { //only run effect function if not frozen
+        if (seg.call > 0 && nowUp != seg._lastRun) {
+          unsigned fpsCurr = (1000U << FPS_CALC_SHIFT) / (nowUp - seg._lastRun); // fixed point math, same as in show()
+          seg._cumulativeFps = (FPS_CALC_AVG * seg._cumulativeFps + fpsCurr + FPS_CALC_AVG / 2) / (FPS_CALC_AVG + 1);
+        }
+        seg._lastRun = nowUp;
         // Effect blending
+        seg.unshareBuffers();               // effect will draw: copy-on-write of buffers shared with a transition snapshot
         uint16_t prog = seg.progress();
         seg.beginDraw(prog);                // set up parameters for get/setPixelColor() (will also blend colors and palette if blend style is FADE)
         _currentSegment = &seg;             // set current segment for effect functions (SEGMENT & SEGENV)
@@ -1338,10 +1674,11 @@ void WS2812FX::service() {
         _mode[seg.mode]();                  // run new/current mode (needed for bri workaround)
         seg.call++;
         // if segment is in transition and no old segment exists we don't need to run the old mode
-        // (blendSegments() takes care of On/Off transitions and clipping)
+        // (blendSegments() takes care of On/Off transitions and clipping), a FADE snapshot only holds the last frame
         Segment *segO = seg.getOldSegment();
-        if (segO && segO->isActive() && (seg.mode != segO->mode || blendingStyle != TRANSITION_FADE ||
-            (segO->name != seg.name && segO->name && seg.name && strncmp(segO->name, seg.name, WLED_MAX_SEGNAME_LEN) != 0))) {
+        if (segO && segO->isActive() && !segO->_frameOnly && (seg.mode != segO->mode || blendingStyle != TRANSITION_FADE ||
+            (segO->name != seg.name && segO->name && seg.name && strncmp(segO->name, seg.name, WLED_MAX_SEGNAME_LEN) != 0)) &&
+            segO->unshareBuffers()) {
           Segment::modeBlend(true);         // set flag for beginDraw() to blend colors and palette
           segO->beginDraw(prog);            // set up palette & colors (also sets draw dimensions), parent segment has transition progress
           _currentSegment = segO;           // set current segment
@@ -1374,20 +1711,12 @@ void WS2812FX::service() {
 }
 
 // https://en.wikipedia.org/wiki/Blend_modes but using a for top layer & b for bottom layer
-static uint8_t _top       (uint8_t a, uint8_t b) { return a; } // function unused
-static uint8_t _bottom    (uint8_t a, uint8_t b) { return b; } // function unused
-static uint8_t _add       (uint8_t a, uint8_t b) { unsigned t = a + b; return t > 255 ? 255 : t; } // function unused
-static uint8_t _subtract  (uint8_t a, uint8_t b) { return b > a ? (b - a) : 0; }
-static uint8_t _difference(uint8_t a, uint8_t b) { return b > a ? (b - a) : (a - b); }
-static uint8_t _average   (uint8_t a, uint8_t b) { return (a + b) >> 1; }
 #if !defined(WLED_HAVE_FAST_int_DIVIDE)
 static uint8_t _multiply  (uint8_t a, uint8_t b) { return ((a * b) + 255) >> 8; } // faster than division on C3/C5 but slightly less accurate
 #else
 static uint8_t _multiply  (uint8_t a, uint8_t b) { return (a * b) / 255; } // origianl uses a & b in range [0,1]
 #endif
 static uint8_t _divide    (uint8_t a, uint8_t b) { return a > b ? (b * 255) / a : 255; }
-static uint8_t _lighten   (uint8_t a, uint8_t b) { return a > b ? a : b; }
-static uint8_t _darken    (uint8_t a, uint8_t b) { return a < b ? a : b; }
 static uint8_t _screen    (uint8_t a, uint8_t b) { return 255 - _multiply(~a,~b); } // 255 - (255-a)*(255-b)/255
 static uint8_t _overlay   (uint8_t a, uint8_t b) { return b < 128 ? 2 * _multiply(a,b) : (255 - 2 * _multiply(~a,~b)); }
 static uint8_t _hardlight (uint8_t a, uint8_t b) { return a < 128 ? 2 * _multiply(a,b) : (255 - 2 * _multiply(~a,~b)); }
@@ -1398,37 +1727,76 @@ static uint8_t _softlight (uint8_t a, uint8_t b) { return (b * b * (255 - 2 * a)
 #endif
 static uint8_t _dodge     (uint8_t a, uint8_t b) { return _divide(~a,b); }
 static uint8_t _burn      (uint8_t a, uint8_t b) { return ~_divide(a,~b); }
-static uint8_t _stencil   (uint8_t a, uint8_t b) { return a ? a : b; } // function unused
-static uint8_t _dummy     (uint8_t a, uint8_t b) { return a; } // dummy (same as _top) to fill the function list and make it safe from OOB access
 
-#define BLENDMODES  17 // number of blend modes must match "bm" in index.js, all cases must be handled in segblend() @ blendSegment()
+// applies a per channel blend function to all 4 channels
+template<uint8_t (*func)(uint8_t, uint8_t)>
+static inline uint32_t _perChannel(uint32_t t, uint32_t b) {
+  return RGBW32(func(R(t),R(b)), func(G(t),G(b)), func(B(t),B(b)), func(W(t),W(b)));
+}
+
+// per channel max(a - b, 0) for all 4 channels at once (two channels per 16 bit lane, the 9th bit of a lane catches the borrow)
+static inline uint32_t _subtractSat(uint32_t a, uint32_t b) {
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  uint32_t rb = (( a       & TWO_CHANNEL_MASK) | 0x01000100) - ( b       & TWO_CHANNEL_MASK);
+  uint32_t wg = (((a >> 8) & TWO_CHANNEL_MASK) | 0x01000100) - ((b >> 8) & TWO_CHANNEL_MASK);
+  rb &= ((rb >> 8) & 0x00010001) * 0xFF; // clear channels that borrowed (b > a)
+  wg &= ((wg >> 8) & 0x00010001) * 0xFF;
+  return (rb & TWO_CHANNEL_MASK) | ((wg & TWO_CHANNEL_MASK) << 8);
+}
+
+// blends top layer pixel t onto bottom layer pixel b, MODE is resolved at compile time
+// https://en.wikipedia.org/wiki/Blend_modes but using t for top layer & b for bottom layer
+template<unsigned MODE>
+static inline uint32_t _blend(uint32_t t, uint32_t b) {
+  switch (MODE) {
+    default:
+    case 0 : return t;                                          // top
+    case 1 : return b;                                          // bottom
+    case 2 : return color_add(t, b, true);                      // add with preserve color ratio to avoid color clipping
+    case 3 : return _subtractSat(b, t);                         // subtract
+    case 4 : return _subtractSat(b, t) | _subtractSat(t, b);    // difference
+    case 5 : return (t & b) + (((t ^ b) & 0xFEFEFEFE) >> 1);    // average (rounded down)
+    case 6 : return _perChannel<_multiply>(t, b);               // multiply
+    case 7 : return _perChannel<_divide>(t, b);                 // divide
+    case 8 : return b + _subtractSat(t, b);                     // lighten: max(t,b)
+    case 9 : return t - _subtractSat(t, b);                     // darken: min(t,b)
+    case 10: return _perChannel<_screen>(t, b);                 // screen
+    case 11: return _perChannel<_overlay>(t, b);                // overlay
+    case 12: return _perChannel<_hardlight>(t, b);              // hard light
+    case 13: return _perChannel<_softlight>(t, b);              // soft light
+    case 14: return _perChannel<_dodge>(t, b);                  // dodge
+    case 15: return _perChannel<_burn>(t, b);                   // burn
+    case 16: return t ? t : b;                                  // stencil (use top layer if not black, else bottom)
+  }
+}
+
+template<unsigned MODE>
+static uint32_t _blendPixel(uint32_t t, uint32_t b, uint8_t opacity) {
+  return color_blend(b, _blend<MODE>(t, b), opacity);
+}
+
+template<unsigned MODE>
+static void _blendRun(uint32_t *dst, int dstStep, const uint32_t *src, int srcStep, size_t count, uint8_t opacity) {
+  if (opacity == 255) for (; count; count--, dst += dstStep, src += srcStep) *dst = _blend<MODE>(*src, *dst); // color_blend(b, c, 255) == c
+  else                for (; count; count--, dst += dstStep, src += srcStep) *dst = color_blend(*dst, _blend<MODE>(*src, *dst), opacity);
+}
+
+WS2812FX::BlendKernel WS2812FX::getBlendKernel(uint8_t blendMode) {
+  #define BLEND_KERNEL(m) case m: return { _blendPixel<m>, _blendRun<m> }
+  switch (blendMode) {
+    BLEND_KERNEL(1);  BLEND_KERNEL(2);  BLEND_KERNEL(3);  BLEND_KERNEL(4);
+    BLEND_KERNEL(5);  BLEND_KERNEL(6);  BLEND_KERNEL(7);  BLEND_KERNEL(8);
+    BLEND_KERNEL(9);  BLEND_KERNEL(10); BLEND_KERNEL(11); BLEND_KERNEL(12);
+    BLEND_KERNEL(13); BLEND_KERNEL(14); BLEND_KERNEL(15); BLEND_KERNEL(16);
+    default: return { _blendPixel<0>, _blendRun<0> };
+  }
+  #undef BLEND_KERNEL
+}
+static_assert(BLENDMODES == 17, "all blend modes must be handled in getBlendKernel()");
 
 void WS2812FX::blendSegment(const Segment &topSegment) const {
-  typedef uint8_t(*FuncType)(uint8_t, uint8_t);
-  // function pointer array: fill with _dummy if using special case: avoid OOB access and always provide a valid path
-  // note: making the function array static const uses more ram and comes at no significant speed gain
-  FuncType funcs[] = {
-    _dummy,      _dummy,     _dummy,    _subtract,
-    _difference, _average,   _dummy,    _divide,
-    _lighten,    _darken,    _screen,   _overlay,
-    _hardlight,  _softlight, _dodge,    _burn,
-    _dummy
-  };
-
-  const size_t blendMode = topSegment.blendMode < BLENDMODES ? topSegment.blendMode : 0; // default to top if unsupported mode
-  const auto segblend = [&](uint32_t t, uint32_t b){
-    // use direct calculations/returns for simple/frequent modes (faster)
-    switch (blendMode) {
-      case 0 : return t;                   // top
-      case 1 : return b;                   // bottom
-      case 2 : return color_add(t,b,true); // add with preserve color ratio to avoid color clipping
-      case 6 : return RGBW32(_multiply(R(t),R(b)), _multiply(G(t),G(b)), _multiply(B(t),B(b)), _multiply(W(t),W(b))); // multiply (7% faster than lambda at 100bytes flash cost)
-      case 16: return t ? t : b;           // stencil (use top layer if not black, else bottom)
-    }
-    // default: use function pointer from array
-    const auto func = funcs[blendMode];
-    return RGBW32(func(R(t),R(b)), func(G(t),G(b)), func(B(t),B(b)), func(W(t),W(b)));
-  };
+  const BlendKernel kernel     = getBlendKernel(topSegment.blendMode); // blend mode is dispatched once per segment
+  const blend_pixel_ptr blend = kernel.pixel;
 
   const int     length     = topSegment.length();     // physical segment length (counts all pixels in 2D segment)
   const int     width      = topSegment.width();
@@ -1445,9 +1813,17 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
   const Segment *segO = topSegment.getOldSegment();
   const bool hasGrouping = topSegment.groupLength() != 1;
 
-  // fast path: handle the default case - no transitions, no grouping/spacing, no mirroring, no CCT
+  // CCT plane: without spacing a segment covers its whole area (whatever its mirroring, grouping or transition)
+  // so it is painted at once, otherwise (or if linear addressing is used on a matrix) every written pixel is painted
+  const bool cctPerPixel = _cctRebuild && (topSegment.spacing > 0 || (isMatrix && stopIndx > matrixSize));
+  if (_cctRebuild && !cctPerPixel) {
+    if (isMatrix) for (unsigned y = topSegment.startY; y < topSegment.stopY; y++) paintCCT(XY(topSegment.start, y), XY(topSegment.stop, y), cct);
+    else          paintCCT(topSegment.start, topSegment.stop, cct);
+  }
+
+  // fast path: handle the default case - no transitions, no grouping/spacing, no mirroring
   if (!segO && blendingStyle == TRANSITION_FADE && !hasGrouping && !topSegment.mirror && !topSegment.mirror_y) {
-    if (isMatrix && stopIndx <= matrixSize && !_pixelCCT) {
+    if (isMatrix && stopIndx <= matrixSize) {
 #ifndef WLED_DISABLE_2D
       // Calculate pointer steps to avoid 'if' and 'XY()' inside loops
       int x_inc = 1;
@@ -1460,46 +1836,36 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         if (topSegment.reverse)   { start_offset += (width - 1); x_inc = -1; }
         if (topSegment.reverse_y) { start_offset += (height - 1) * Segment::maxWidth; y_inc = -Segment::maxWidth; }
 
-        for (int y = 0; y < height; y++) {
-          uint32_t* pRow = &_pixels[start_offset + y * y_inc];
-          const int y_width = y * width;
-          for (int x = 0; x < width; x++) {
-            uint32_t* p = pRow + x * x_inc;
-            uint32_t c_a = topSegment.getPixelColorRaw(x + y_width);
-            *p = color_blend(*p, segblend(c_a, *p), opacity);
-          }
-        }
+        for (int y = 0; y < height; y++) kernel.run(&_pixels[start_offset + y * y_inc], x_inc, &topSegment.pixels[y * width], 1, width, opacity);
       } else { // transposed
+        // source pixel of (x,y) is (y,x) in a segment with virtual width = height, reversed if needed
+        const int srcStep = topSegment.reverse_y ? -height : height;
+        const int srcBase = topSegment.reverse_y ? (width - 1) * height : 0;
         for (int y = 0; y < height; y++) {
-          const int px = topSegment.reverse ? (height - y - 1) : y;  // source pixel: swap y into x, reverse if needed
-          for (int x = 0; x < width; x++) {
-            const int py = topSegment.reverse_y ? (width  - x - 1) : x;  // source pixel: swap x into y, reverse if needed
-            const uint32_t c_a = topSegment.getPixelColorRaw(px + py * height); // height = virtual width
-            const size_t idx = XY(topSegment.start + x, topSegment.startY + y); // write logical (non swapped) pixel coordinate
-            _pixels[idx] = color_blend(_pixels[idx], segblend(c_a, _pixels[idx]), opacity);
-          }
+          const int px = topSegment.reverse ? (height - y - 1) : y;
+          kernel.run(&_pixels[XY(topSegment.start, topSegment.startY + y)], 1, &topSegment.pixels[srcBase + px], srcStep, width, opacity);
         }
       }
       return;
 #endif
     } else if (!isMatrix) {
-      // 1D fast path, include CCT as it is more common on 1D setups
-      uint32_t* strip = _pixels;
-      int start = topSegment.start;
-      int off   = topSegment.offset;
-      for (int i = 0; i < length; i++) {
-        uint32_t c_a = topSegment.getPixelColorRaw(i);
-        int p = topSegment.reverse ? (length - i - 1) : i;
-        int idx = start + p + off;
-        if (idx >= topSegment.stop) idx -= length;
-        strip[idx] = color_blend(strip[idx], segblend(c_a, strip[idx]), opacity);
-        if (_pixelCCT) _pixelCCT[idx] = cct;
+      // 1D fast path: the offset splits the segment into two runs
+      // (offset is not limited to the length: it comes raw from sync packets and is kept when a segment shrinks)
+      uint32_t *strip = &_pixels[topSegment.start];
+      const uint32_t *src = topSegment.pixels;
+      const int off = length > 0 ? topSegment.offset % length : 0;
+      if (topSegment.reverse) {
+        kernel.run(strip + off - 1, -1, src, 1, off, opacity);
+        kernel.run(strip + length - 1, -1, src + off, 1, length - off, opacity);
+      } else {
+        kernel.run(strip + off, 1, src, 1, length - off, opacity);
+        kernel.run(strip, 1, src + length - off, 1, off, opacity);
       }
       return;
     }
   }
 
-  // slow path: handle transitions, grouping/spacing, segments with clipping and CCT pixels
+  // slow path: handle transitions, grouping/spacing, segments with clipping
   Segment::setClippingRect(0, 0);  // disable clipping by default
   const unsigned progress = topSegment.progress();
   const unsigned progInv  = 0xFFFFU - progress;
@@ -1570,8 +1936,8 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
       const int baseX = topSegment.start  + x;
       const int baseY = topSegment.startY + y;
       size_t indx = XY(baseX, baseY); // absolute address on strip
-      _pixels[indx] = color_blend(_pixels[indx], segblend(c, _pixels[indx]), o);
-      if (_pixelCCT) _pixelCCT[indx] = cct;
+      _pixels[indx] = blend(c, _pixels[indx], o);
+      if (cctPerPixel) paintCCT(indx, indx + 1, cct);
       // Apply mirroring if enabled
       if (topSegment.mirror || topSegment.mirror_y) {
         const int mirrorX = topSegment.start  + width  - x - 1;
@@ -1579,13 +1945,13 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         const size_t idxMX = XY(topSegment.transpose ? baseX : mirrorX, topSegment.transpose ? mirrorY : baseY);
         const size_t idxMY = XY(topSegment.transpose ? mirrorX : baseX, topSegment.transpose ? baseY : mirrorY);
         const size_t idxMM = XY(mirrorX, mirrorY);
-        if (topSegment.mirror)                        _pixels[idxMX] = color_blend(_pixels[idxMX], segblend(c, _pixels[idxMX]), o);
-        if (topSegment.mirror_y)                      _pixels[idxMY] = color_blend(_pixels[idxMY], segblend(c, _pixels[idxMY]), o);
-        if (topSegment.mirror && topSegment.mirror_y) _pixels[idxMM] = color_blend(_pixels[idxMM], segblend(c, _pixels[idxMM]), o);
-        if (_pixelCCT) {
-          if (topSegment.mirror)                        _pixelCCT[idxMX] = cct;
-          if (topSegment.mirror_y)                      _pixelCCT[idxMY] = cct;
-          if (topSegment.mirror && topSegment.mirror_y) _pixelCCT[idxMM] = cct;
+        if (topSegment.mirror)                        _pixels[idxMX] = blend(c, _pixels[idxMX], o);
+        if (topSegment.mirror_y)                      _pixels[idxMY] = blend(c, _pixels[idxMY], o);
+        if (topSegment.mirror && topSegment.mirror_y) _pixels[idxMM] = blend(c, _pixels[idxMM], o);
+        if (cctPerPixel) {
+          if (topSegment.mirror)                        paintCCT(idxMX, idxMX + 1, cct);
+          if (topSegment.mirror_y)                      paintCCT(idxMY, idxMY + 1, cct);
+          if (topSegment.mirror && topSegment.mirror_y) paintCCT(idxMM, idxMM + 1, cct);
         }
       }
     };
@@ -1671,13 +2037,13 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         unsigned indxM = topSegment.stop - i - 1;
         indxM += topSegment.offset; // offset/phase
         if (indxM >= topSegment.stop) indxM -= length; // wrap
-        _pixels[indxM] = color_blend(_pixels[indxM], segblend(c, _pixels[indxM]), o);
-        if (_pixelCCT) _pixelCCT[indxM] = cct;
+        _pixels[indxM] = blend(c, _pixels[indxM], o);
+        if (cctPerPixel) paintCCT(indxM, indxM + 1, cct);
       }
       indx += topSegment.offset; // offset/phase
       if (indx >= topSegment.stop) indx -= length; // wrap
-      _pixels[indx] = color_blend(_pixels[indx], segblend(c, _pixels[indx]), o);
-      if (_pixelCCT) _pixelCCT[indx] = cct;
+      _pixels[indx] = blend(c, _pixels[indx], o);
+      if (cctPerPixel) paintCCT(indx, indx + 1, cct);
     };
 
     // if we blend using "push" style we need to "shift" canvas to left/right/
@@ -1723,60 +2089,227 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
   Segment::setClippingRect(0, 0);             // disable clipping for overlays
 }
 
-void WS2812FX::show() {
-  if (!_pixels) {
-    DEBUGFX_PRINTLN(F("Error: no _pixels!"));
-    errorFlag = ERR_NORAM;
-    return; // no pixels allocated, nothing to show
-  }
+// FNV-1a, used to detect changes of the parameters that determine composition and output of a frame
+static inline void hashAdd(uint32_t &hash, uint32_t value) {
+  for (unsigned i = 0; i < 4; i++, value >>= 8) { hash ^= value & 0xFF; hash *= 16777619UL; }
+}
 
-  unsigned long showNow = millis();
-  size_t diff = showNow - _lastShow;
+uint32_t WS2812FX::frameHash() const {
+  uint32_t hash = 2166136261UL;
+  hashAdd(hash, _segments.size());
+  hashAdd(hash, blendingStyle | (gammaCorrectCol << 8) | (isMatrix << 9));
+  hashAdd(hash, Segment::maxWidth | (Segment::maxHeight << 16));
+  hashAdd(hash, getLengthTotal());
+  hashAdd(hash, (uintptr_t)_pixels);
+  for (const Segment &seg : _segments) {
+    hashAdd(hash, seg.start | (seg.stop << 16));
+    hashAdd(hash, seg.startY | (seg.stopY << 16));
+    hashAdd(hash, seg.offset | (seg.options << 16));
+    hashAdd(hash, seg.grouping | (seg.spacing << 8) | (seg.blendMode << 16) | (seg.currentBri() << 24));
+    hashAdd(hash, seg.currentCCT() | (seg.isActive() << 8) | ((seg.on || seg.isInTransition()) << 9));
+  }
+  return hash;
+}
+
+void WS2812FX::resetCCT(size_t len) {
+  _cctSpans.assign(1, CCTSpan{0, uint16_t(len), 127}); // neutral (50:50) CCT
+}
+
+// overwrites the CCT of pixels [from,to): the spans it covers are replaced, neighbouring spans with the same CCT are merged
+void WS2812FX::paintCCT(unsigned from, unsigned to, uint8_t cct) const {
+  if (from >= to || _cctSpans.empty()) return;
+  const unsigned total = _cctSpans.back().start + _cctSpans.back().len;
+  if (to > total) to = total;
+  if (from >= to) return;
+  // index of the span containing pixel p (spans are sorted and cover all pixels)
+  const auto spanOf = [this](unsigned p) {
+    size_t lo = 0, hi = _cctSpans.size();
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      if (_cctSpans[mid].start <= p) lo = mid + 1; else hi = mid;
+    }
+    return lo - 1;
+  };
+  size_t first = spanOf(from);
+  size_t last  = spanOf(to - 1);
+  if (first == last && _cctSpans[first].cct == cct) return; // most common case: nothing changes
+  // new runs: remainder of first span, painted run, remainder of last span
+  CCTSpan runs[3];
+  size_t  n = 0;
+  const CCTSpan head = _cctSpans[first];
+  const CCTSpan tail = _cctSpans[last];
+  if (from > head.start) runs[n++] = {head.start, uint16_t(from - head.start), head.cct};
+  runs[n++] = {uint16_t(from), uint16_t(to - from), cct};
+  if (to < unsigned(tail.start + tail.len)) runs[n++] = {uint16_t(to), uint16_t(tail.start + tail.len - to), tail.cct};
+  // include neighbours so runs with the same CCT can be merged
+  if (first > 0 && _cctSpans[first-1].cct == runs[0].cct) { runs[0].start = _cctSpans[first-1].start; runs[0].len += _cctSpans[first-1].len; first--; }
+  if (last + 1 < _cctSpans.size() && _cctSpans[last+1].cct == runs[n-1].cct) { runs[n-1].len += _cctSpans[last+1].len; last++; }
+  size_t m = 0;
+  for (size_t i = 1; i < n; i++) {
+    if (runs[i].cct == runs[m].cct) runs[m].len += runs[i].len;
+    else runs[++m] = runs[i];
+  }
+  n = m + 1;
+  // replace spans [first,last] with the runs
+  const size_t replaced = last - first + 1;
+  if (replaced > n) _cctSpans.erase(_cctSpans.begin() + first + n, _cctSpans.begin() + last + 1);
+  else if (replaced < n) _cctSpans.insert(_cctSpans.begin() + last + 1, n - replaced, CCTSpan{});
+  std::copy(runs, runs + n, _cctSpans.begin() + first);
+}
+
+void WS2812FX::markDirty(size_t from, size_t to) {
+  if (from >= to) return;
+  for (size_t b = from / DIRTY_BLOCK_SIZE; b <= (to - 1) / DIRTY_BLOCK_SIZE; b++) _dirtyBlocks[b >> 5] |= 1UL << (b & 31);
+}
+
+// blends segments into _pixels: if the way segments are blended did not change only segments whose pixels changed
+// (and segments overlapping them) are redrawn, everything else is left from the previous frame
+void WS2812FX::composeFrame() {
+  const size_t totalLen = getLengthTotal();
+  const uint32_t hash = frameHash();
+  const auto visible = [](const Segment &seg) { return seg.isActive() && (seg.on || seg.isInTransition()); };
+  // segments outside the matrix are blended using linear addressing
+  bool redrawAll = _redrawAll || hash != _frameHash;
+  for (const Segment &seg : _segments) {
+    if (!visible(seg)) continue;
+    if (seg.stop > Segment::maxWidth || seg.stopY > Segment::maxHeight) redrawAll = true;
+    if (seg.isInTransition()) seg._dirty = true; // old segment and transition style change every frame
+  }
+  _frameHash = hash;
+  _redrawAll = false;
 
-  size_t totalLen = getLengthTotal();
-  // WARNING: as WLED doesn't handle CCT on pixel level but on Segment level instead
-  // we need to keep track of each pixel's CCT when blending segments (if CCT is present)
-  // and then set appropriate CCT from that pixel during paint (see below).
-  if ((hasCCTBus() || correctWB) && !cctFromRgb)
-    _pixelCCT = static_cast<uint8_t*>(allocate_buffer(totalLen * sizeof(uint8_t), BFRALLOC_PREFER_PSRAM)); // allocate CCT buffer if necessary, prefer PSRAM
-  if (_pixelCCT) memset(_pixelCCT, 127, totalLen); // set neutral (50:50) CCT
+  // CCT plane (if used) only changes if the way segments are blended changes, it is painted while all segments are redrawn
+  const bool useCCT = (hasCCTBus() || correctWB) && !cctFromRgb;
+  if (!useCCT) _cctSpans.clear();
+  else if (_cctSpans.empty() || _cctSpans.back().start + _cctSpans.back().len != totalLen) redrawAll = true;
 
-  if (realtimeMode == REALTIME_MODE_INACTIVE || useMainSegmentOnly || realtimeOverride > REALTIME_OVERRIDE_NONE) {
-    // clear frame buffer
+  if (redrawAll) {
     memset(_pixels, 0, sizeof(uint32_t) * totalLen);
-    // blend all segments into (cleared) buffer
-    for (Segment &seg : _segments) if (seg.isActive() && (seg.on || seg.isInTransition())) {
-      blendSegment(seg);              // blend segment's buffer into frame buffer
+    if (useCCT) resetCCT(totalLen);
+    _cctRebuild = useCCT;
+    for (Segment &seg : _segments) if (visible(seg)) blendSegment(seg);
+    _cctRebuild = false;
+    markDirty(0, totalLen);
+  } else {
+    // a redrawn segment's area is cleared first which also erases segments overlapping it, so those need redrawing as well
+    const auto overlaps = [](const Segment &a, const Segment &b) {
+      return a.start < b.stop && b.start < a.stop && a.startY < b.stopY && b.startY < a.stopY;
+    };
+    bool added;
+    do {
+      added = false;
+      for (const Segment &seg : _segments) {
+        if (!seg._dirty || !visible(seg)) continue;
+        for (const Segment &other : _segments) {
+          if (!other._dirty && visible(other) && overlaps(seg, other)) other._dirty = added = true;
+        }
+      }
+    } while (added);
+    for (const Segment &seg : _segments) {
+      if (!seg._dirty || !visible(seg)) continue;
+      for (unsigned y = seg.startY; y < seg.stopY; y++) {
+        const size_t row = y * Segment::maxWidth;
+        memset(&_pixels[row + seg.start], 0, sizeof(uint32_t) * (seg.stop - seg.start));
+        markDirty(row + seg.start, row + seg.stop);
+      }
     }
+    for (Segment &seg : _segments) if (seg._dirty && visible(seg)) blendSegment(seg); // keep segment order
+  }
+  for (const Segment &seg : _segments) seg._dirty = false;
+}
+
+// hands the composited frame to sink(start, colors, len) in runs of consecutive physical pixels
+// a run ends at a gap in the LED map, when the CCT changes (the new CCT is set before the next run) or when the run buffer is full
+// if blocks is given, only blocks of DIRTY_BLOCK_SIZE pixels with their bit set are handed over
+template<typename Sink>
+void WS2812FX::forEachPixelRun(const uint32_t *pixels, const std::vector<CCTSpan> &cctSpans, size_t totalLen, const uint32_t *blocks, Sink sink) const {
+  constexpr size_t RUN_MAX = 64;
+  uint32_t run[RUN_MAX];
+  size_t   runLen   = 0;
+  unsigned runStart = 0;
+  size_t   span     = 0;
+  unsigned spanEnd  = 0;  // CCT is set at the first pixel of each span that is handed over
+  int      busCCT   = -1; // CCT set on the buses (-1: not set yet)
+  for (size_t i = 0; i < totalLen; i++) {
+    if (blocks && i % DIRTY_BLOCK_SIZE == 0) {
+      const size_t block = i / DIRTY_BLOCK_SIZE;
+      if (!((blocks[block >> 5] >> (block & 31)) & 1)) {
+        if (runLen) sink(runStart, run, runLen);
+        runLen = 0;
+        i += DIRTY_BLOCK_SIZE - 1;
+        continue;
+      }
+    }
+    // when correctWB is true setSegmentCCT() will convert CCT into K with which we can then
+    // correct/adjust RGB value according to desired CCT value, it will still affect actual WW/CW ratio
+    if (i >= spanEnd && span < cctSpans.size()) { // no spans if cctFromRgb or no bus needs CCT
+      while (span + 1 < cctSpans.size() && i >= unsigned(cctSpans[span].start + cctSpans[span].len)) span++;
+      spanEnd = cctSpans[span].start + cctSpans[span].len;
+      if (cctSpans[span].cct != busCCT) {
+        if (runLen) sink(runStart, run, runLen);
+        runLen = 0;
+        busCCT = cctSpans[span].cct;
+        BusManager::setSegmentCCT(busCCT, correctWB);
+      }
+    }
+
+    const uint32_t c = pixels[i]; // gamma is applied by the buses (see Bus::setGammaCorrection())
+    const unsigned index = getMappedPixelIndex(i);
+    if (runLen == RUN_MAX || (runLen && index != runStart + runLen)) {
+      sink(runStart, run, runLen);
+      runLen = 0;
+    }
+    if (runLen == 0) runStart = index;
+    run[runLen++] = c;
   }
+  if (runLen) sink(runStart, run, runLen);
+}
 
-  // avoid race condition, capture _callback value
-  show_callback callback = _callback;
-  if (callback) callback(); // will call setPixelColor or setRealtimePixelColor
+// writes a composited frame to the buses and sends it (called from show() or from the output task)
+// blocks marks the pixels that changed in this or the previous frame (see show())
+void WS2812FX::outputFrame(const uint32_t *pixels, const std::vector<CCTSpan> &cctSpans, size_t len, const uint32_t *blocks, bool useGammaCorrection) {
+  unsigned long showNow = millis();
+  size_t diff = showNow - _lastShow;
 
   // paint actual pixels
   int oldCCT = Bus::getCCT(); // store original CCT value (since it is global)
   // when cctFromRgb is true we implicitly calculate WW and CW from RGB values (cct==-1)
   if (cctFromRgb) BusManager::setSegmentCCT(-1);
-  // use color gamma correction if enabled, not in realtime mode with gamma disabled or currently overriding RT mode
-  bool useGammaCorrection = gammaCorrectCol && !(realtimeMode && arlsDisableGammaCorrection && !realtimeOverride);
-
-  for (size_t i = 0; i < totalLen; i++) {
-    // when correctWB is true setSegmentCCT() will convert CCT into K with which we can then
-    // correct/adjust RGB value according to desired CCT value, it will still affect actual WW/CW ratio
-    if (_pixelCCT) { // cctFromRgb already exluded at allocation
-      if (i == 0 || _pixelCCT[i-1] != _pixelCCT[i]) BusManager::setSegmentCCT(_pixelCCT[i], correctWB);
+  // buses apply gamma correction together with brightness and white balance (look-up tables in BusDigital)
+  // note: applying gamma after brightness has too much color loss
+  Bus::setGammaCorrection(useGammaCorrection);
+
+  // a full write is needed in this and the next frame (NeoPixelBus buffers) if output parameters changed
+  // and in the two frames after ABL was limiting (the previous frame in the other buffer is still limited)
+  bool fullOutput = _fullOutputFrames > 0;
+  if (_fullOutputFrames) _fullOutputFrames--;
+  // predict the current from the composited frame so ABL can be applied while writing (no re-read of bus buffers)
+  if (BusManager::_useABL) {
+    BusManager::beginABLPrediction();
+    forEachPixelRun(pixels, cctSpans, len, nullptr, BusManager::predictCurrent);
+    BusManager::applyABL(); // calculate brightness limit, updates _gMilliAmpsUsed
+    if (BusManager::currentMilliamps() < BusManager::predictedMilliamps()) { // limit applies to all pixels
+      fullOutput = true;
+      _fullOutputFrames = 2;
     }
-
-    uint32_t c = _pixels[i]; // need a copy, do not modify _pixels directly (no byte access allowed on ESP32)
-    if (c > 0 && useGammaCorrection)
-      c = gamma32(c); // apply gamma correction if enabled note: applying gamma after brightness has too much color loss
-    BusManager::setPixelColor(getMappedPixelIndex(i), c);
   }
+  // unchanged pixels are only skipped if they would be output the same way as before
+  uint32_t outputHash = 2166136261UL;
+  uint32_t gammaBits;
+  memcpy(&gammaBits, &gammaCorrectVal, sizeof(gammaBits));
+  hashAdd(outputHash, _brightness | (useGammaCorrection << 8) | (cctFromRgb << 9) | (correctWB << 10) | (Bus::getGlobalAWMode() << 16));
+  hashAdd(outputHash, gammaBits);
+  hashAdd(outputHash, (uint16_t)Bus::getCCT() | ((uint8_t)Bus::getCCTBlend() << 16));
+  hashAdd(outputHash, (uintptr_t)customMappingTable);
+  hashAdd(outputHash, customMappingSize | (BusManager::getNumBusses() << 16));
+  if (outputHash != _outputHash) {
+    fullOutput = true;
+    if (!_fullOutputFrames) _fullOutputFrames = 1;
+  }
+  _outputHash = outputHash;
+  forEachPixelRun(pixels, cctSpans, len, fullOutput ? nullptr : blocks, BusManager::setPixelColors);
   Bus::setCCT(oldCCT);  // restore old CCT for ABL adjustments
-
-  p_free(_pixelCCT);
-  _pixelCCT = nullptr;
+  Bus::setGammaCorrection(false); // only colors handed over here are not gamma corrected yet
 
   // some buses send asynchronously and this method will return before
   // all of the data has been sent.
@@ -1790,15 +2323,142 @@ void WS2812FX::show() {
   }
 }
 
+#ifdef WLED_OUTPUT_TASK
+// output task: sends the frame handed over by show() while loop() renders the next one
+void WS2812FX::outputTask(void *arg) {
+  WS2812FX *instance = static_cast<WS2812FX*>(arg);
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    instance->outputFrame(instance->_pixelsOut, instance->_cctSpansOut, instance->_pixelsOutLen, instance->_outputBlocks.data(), instance->_outputGamma);
+    instance->_outputBusy = false;
+  }
+}
+
+// waits until the output task has sent its frame, its buffers may be modified afterwards
+void WS2812FX::waitForOutput() const {
+  while (_outputBusy) yield(); // output task runs on the other core
+}
+#endif
+
+void WS2812FX::show() {
+  if (!_pixels) {
+    DEBUGFX_PRINTLN(F("Error: no _pixels!"));
+    errorFlag = ERR_NORAM;
+    return; // no pixels allocated, nothing to show
+  }
+
+  size_t totalLen = getLengthTotal();
+  // buffers below are kept between frames, they are only (re)allocated if the setup changes
+  const auto capacity = [this]() {
+    size_t c = _cctSpans.capacity() + _dirtyBlocks.capacity() + _outputBlocks.capacity();
+#ifdef WLED_OUTPUT_TASK
+    c += _cctSpansOut.capacity();
+#endif
+    return c;
+  };
+  const size_t oldCapacity = capacity();
+
+  // changed blocks: current frame's bits become previous frame's bits
+  const size_t dirtyWords = (totalLen + 32*DIRTY_BLOCK_SIZE - 1) / (32*DIRTY_BLOCK_SIZE);
+  if (_dirtyBlocks.size() != 2*dirtyWords) {
+    _dirtyBlocks.assign(2*dirtyWords, ~0U);
+    _redrawAll = true;
+  }
+  std::copy(_dirtyBlocks.begin(), _dirtyBlocks.begin() + dirtyWords, _dirtyBlocks.begin() + dirtyWords);
+  std::fill(_dirtyBlocks.begin(), _dirtyBlocks.begin() + dirtyWords, 0);
+
+  if (realtimeMode == REALTIME_MODE_INACTIVE || useMainSegmentOnly || realtimeOverride > REALTIME_OVERRIDE_NONE) {
+    if (_pixelsOverwritten) _redrawAll = true; // _pixels were written outside of segments since last frame
+    composeFrame();                  // blend (changed) segments into frame buffer
+  } else {
+    _redrawAll = true;               // realtime data has to be replaced when segments are shown again
+    markDirty(0, totalLen);
+    if ((hasCCTBus() || correctWB) && !cctFromRgb) resetCCT(totalLen); // realtime data uses neutral CCT
+    else _cctSpans.clear();
+  }
+  _pixelsOverwritten = false;
+
+  // avoid race condition, capture _callback value
+  show_callback callback = _callback;
+  if (callback) callback(); // will call setPixelColor or setRealtimePixelColor
+  if (_pixelsOverwritten) {
+    markDirty(0, totalLen);
+    _redrawAll = true;       // overlay has to be removed from _pixels in next frame
+    _pixelsOverwritten = false;
+  }
+
+  // use color gamma correction if enabled, not in realtime mode with gamma disabled or currently overriding RT mode
+  bool useGammaCorrection = gammaCorrectCol && !(realtimeMode && arlsDisableGammaCorrection && !realtimeOverride);
+
+#ifdef WLED_OUTPUT_TASK
+  if (!_outputTask) xTaskCreatePinnedToCore(outputTask, "LEDOutput", 8192, this, 1, &_outputTask, xPortGetCoreID() ? 0 : 1); // same priority as loop()
+  if (_outputTask) {
+    // hand frame over to the output task: only blocks changed in this frame need to be copied to the output buffer
+    waitForOutput();
+    if (_pixelsOutLen != totalLen) {
+      p_free(_pixelsOut);
+      _pixelsOut = static_cast<uint32_t*>(allocate_buffer(totalLen * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
+      _pixelsOutLen = _pixelsOut ? totalLen : 0;
+      _frameAllocs++;
+      markDirty(0, totalLen);
+    }
+    if (_pixelsOut) {
+      for (size_t b = 0; b * DIRTY_BLOCK_SIZE < totalLen; b++) {
+        if (!((_dirtyBlocks[b >> 5] >> (b & 31)) & 1)) continue;
+        const size_t from = b * DIRTY_BLOCK_SIZE;
+        memcpy(&_pixelsOut[from], &_pixels[from], sizeof(uint32_t) * std::min(size_t(DIRTY_BLOCK_SIZE), totalLen - from));
+      }
+      _outputBlocks.resize(dirtyWords);
+      for (size_t w = 0; w < dirtyWords; w++) _outputBlocks[w] = _dirtyBlocks[w] | _dirtyBlocks[dirtyWords + w];
+      _cctSpansOut  = _cctSpans; // reuses capacity of the previous copy
+      _outputGamma  = useGammaCorrection;
+      if (capacity() > oldCapacity) _frameAllocs++;
+      _outputBusy   = true;
+      xTaskNotifyGive(_outputTask);
+      return;
+    }
+    DEBUGFX_PRINTLN(F("Output buffer allocation failed, sending directly."));
+  }
+#endif
+  // NeoPixelBus swaps its buffers on show() (without keeping them consistent), so a block has to be written
+  // if it changed in this frame or in the previous one
+  _outputBlocks.resize(dirtyWords);
+  for (size_t w = 0; w < dirtyWords; w++) _outputBlocks[w] = _dirtyBlocks[w] | _dirtyBlocks[dirtyWords + w];
+  if (capacity() > oldCapacity) _frameAllocs++;
+  outputFrame(_pixels, _cctSpans, totalLen, _outputBlocks.data(), useGammaCorrection);
+}
+
 void WS2812FX::setRealtimePixelColor(unsigned i, uint32_t c) {
   if (useMainSegmentOnly) {
-    const Segment &seg = getMainSegment();
-    if (seg.isActive() && i < seg.length()) seg.setPixelColorRaw(i, c);
+    Segment &seg = getMainSegment();
+    if (seg.isActive() && i < seg.length() && seg.unshareBuffers()) seg.setPixelColorRaw(i, c); // copy-on-write, a transition snapshot may share the buffer
   } else {
     setPixelColor(i, c);
   }
 }
 
+// bulk version of setRealtimePixelColor(): copies count LEDs of 3 (RGB) or 4 (RGBW) bytes each from a realtime
+// packet straight into the target buffer, bounds are checked once instead of per pixel
+void WS2812FX::setRealtimePixelColors(unsigned i, const uint8_t *data, size_t count, unsigned channels) {
+  uint32_t *dest;
+  size_t len;
+  if (useMainSegmentOnly) {
+    Segment &seg = getMainSegment();
+    if (!seg.isActive() || !seg.unshareBuffers()) return; // copy-on-write, a transition snapshot may share the buffer
+    dest = seg.getPixels(); // marks segment dirty
+    len  = seg.length();
+  } else {
+    dest = _pixels;
+    len  = getLengthTotal();
+    _pixelsOverwritten = true;
+  }
+  if (!dest || i >= len) return;
+  if (count > len - i) count = len - i;
+  dest += i;
+  if (channels == 4) for (size_t n = 0; n < count; n++, data += 4) dest[n] = RGBW32(data[0], data[1], data[2], data[3]);
+  else               for (size_t n = 0; n < count; n++, data += channels) dest[n] = RGBW32(data[0], data[1], data[2], 0);
+}
+
 // reset all segments
 void WS2812FX::restartRuntime() {
   suspend();
@@ -1824,6 +2484,7 @@ void WS2812FX::waitForIt() {
   unsigned long waitStart = millis();
   unsigned long maxWait = 2*getFrameTime() + 100; // TODO: this needs a proper fix for timeout! see #4779
   while (isServicing() && (millis() - waitStart < maxWait)) delay(1); // safe even when millis() rolls over
+  waitForOutput();
   #ifdef WLED_DEBUG
   if (millis()-waitStart >= maxWait) DEBUG_PRINTLN(F("Waited for strip to finish servicing."));
   #endif
@@ -1852,6 +2513,7 @@ void WS2812FX::setBrightness(uint8_t b, bool direct) {
   if (_brightness == 0) { //unfreeze all segments on power off
     for (const Segment &seg : _segments) seg.freeze = false; // freeze is mutable
   }
+  waitForOutput(); // output task may be sending with the current brightness
   BusManager::setBrightness(scaledBri(b));
   if (!direct) {
     unsigned long t = millis();
@@ -2113,8 +2775,10 @@ bool WS2812FX::deserializeMap(unsigned n) {
   strcat_P(fileName, PSTR(".json"));
   bool isFile = WLED_FS.exists(fileName);
 
+  waitForOutput();       // output task uses mapping
   customMappingSize = 0; // prevent use of mapping if anything goes wrong
   currentLedmap = 0;
+  _redrawAll = true;     // mapping changes which LEDs show which pixel
   if (n == 0 || isFile) interfaceUpdateCallMode = CALL_MODE_WS_SEND; // schedule WS update (to inform UI)
   uint32_t lengthTotalBefore = strip.getLengthTotal();
 
@@ -18,9 +18,13 @@
 static int32_t calcForce_dv(const int8_t force, uint8_t &counter);
 static bool checkBoundsAndWrap(int32_t &position, const int32_t max, const int32_t particleradius, const bool wrap); // returns false if out of bounds by more than particleradius
 static uint32_t fast_color_scaleAdd(const uint32_t c1, const uint32_t c2, uint8_t scale = 255); // fast and accurate color adding with scaling (scales c2 before adding)
+template<typename T> static inline void shiftPointer(T *&p, const ptrdiff_t offset) { if (p) p = reinterpret_cast<T *>(reinterpret_cast<uint8_t *>(p) + offset); }
 #endif
 
 #ifndef WLED_DISABLE_PARTICLESYSTEM2D
+// collision grid (see handleCollisions()): start indices of up to numparticles + 16 cells and the particle list, multiple of 4 bytes
+static inline uint32_t collisionGridSize2D(const uint32_t numparticles) { return (2 * numparticles + 18) * sizeof(uint16_t); }
+
 ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t numberofparticles, uint32_t numberofsources, bool isadvanced, bool sizecontrol) {
   PSPRINTLN("\n ParticleSystem2D constructor");
   numSources = numberofsources; // number of sources allocated in init
@@ -36,8 +40,8 @@ ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t num
   setParticleSize(1); // 2x2 rendering size by default (disables per particle size control by default)
   motionBlur = 0; //no fading by default
   smearBlur = 0; //no smearing by default
+  smearType = PS_BLUR_SMEAR;
   emitIndex = 0;
-  collisionStartIdx = 0;
 
   //initialize some default non-zero values most FX use
   for (uint32_t i = 0; i < numParticles; i++) {
@@ -71,11 +75,7 @@ void ParticleSystem2D::update(void) {
   if (particlesettings.useCollisions)
     handleCollisions();
 
-  //move all particles
-  for (uint32_t i = 0; i < usedParticles; i++) {
-    particleMoveUpdate(particles[i], particleFlags[i], nullptr, advPartProps ? &advPartProps[i] : nullptr); // note: splitting this into two loops is slower and uses more flash
-  }
-
+  moveParticles(); //move all particles
   render();
 }
 
@@ -142,8 +142,9 @@ void ParticleSystem2D::setMotionBlur(uint8_t bluramount) {
     motionBlur = bluramount;
 }
 
-void ParticleSystem2D::setSmearBlur(uint8_t bluramount) {
+void ParticleSystem2D::setSmearBlur(uint8_t bluramount, uint8_t blurtype) {
   smearBlur = bluramount;
+  smearType = blurtype;
 }
 
 
@@ -226,6 +227,51 @@ int32_t ParticleSystem2D::angleEmit(PSsource &emitter, const uint16_t angle, con
   return sprayEmit(emitter);
 }
 
+// move, age and kill one living particle, shared by particleMoveUpdate() and moveParticles()
+// renderradius is used to check out of bounds, hardRadius is the distance at which particles bounce off walls
+inline void ParticleSystem2D::moveParticle(PSparticle &part, PSparticleFlags &partFlags, const PSsettings2D &options, const int32_t renderradius, const int32_t hardRadius) {
+  if (!partFlags.perpetual)
+    part.ttl--; // age
+  if (options.colorByAge)
+    part.hue = min(part.ttl, (uint16_t)255); //set color to ttl
+
+  int32_t newX = part.x + (int32_t)part.vx;
+  int32_t newY = part.y + (int32_t)part.vy;
+  partFlags.outofbounds = false; // reset out of bounds (in case particle was created outside the matrix and is now moving into view) note: moving this to checks below adds code and is not faster
+
+  // note: if wall collisions are enabled, bounce them before they reach the edge, it looks much nicer if the particle does not go half out of view
+  if (options.bounceY) {
+    if ((newY < hardRadius) || ((newY > maxY - hardRadius) && !options.useGravity)) { // reached floor / ceiling
+       bounce(part.vy, part.vx, newY, maxY);
+    }
+  }
+
+  if (!checkBoundsAndWrap(newY, maxY, renderradius, options.wrapY)) { // check out of bounds  note: this must not be skipped. if gravity is enabled, particles will never bounce at the top
+    partFlags.outofbounds = true;
+    if (options.killoutofbounds) {
+      if (newY < 0) // if gravity is enabled, only kill particles below ground
+        part.ttl = 0;
+      else if (!options.useGravity)
+        part.ttl = 0;
+    }
+  }
+
+  if (part.ttl) { //check x direction only if still alive
+    if (options.bounceX) {
+      if ((newX < hardRadius) || (newX > maxX - hardRadius)) // reached a wall
+        bounce(part.vx, part.vy, newX, maxX);
+    }
+    else if (!checkBoundsAndWrap(newX, maxX, renderradius, options.wrapX)) { // check out of bounds
+      partFlags.outofbounds = true;
+      if (options.killoutofbounds)
+        part.ttl = 0;
+    }
+  }
+
+  part.x = (int16_t)newX; // set new position
+  part.y = (int16_t)newY; // set new position
+}
+
 // particle moves, decays and dies, if killoutofbounds is set, out of bounds particles are set to ttl=0
 // uses passed settings to set bounce or wrap, if useGravity is enabled, it will never bounce at the top and killoutofbounds is not applied over the top
 void ParticleSystem2D::particleMoveUpdate(PSparticle &part, PSparticleFlags &partFlags, PSsettings2D *options, PSadvancedParticle *advancedproperties) {
@@ -233,16 +279,7 @@ void ParticleSystem2D::particleMoveUpdate(PSparticle &part, PSparticleFlags &par
     options = &particlesettings; //use PS system settings by default
 
   if (part.ttl > 0) {
-    if (!partFlags.perpetual)
-      part.ttl--; // age
-    if (options->colorByAge)
-      part.hue = min(part.ttl, (uint16_t)255); //set color to ttl
-
     int32_t renderradius = PS_P_HALFRADIUS - 1 + particlesize; // used to check out of bounds, if its more than half a radius out of bounds, it will render to x = -2/-1 or x=max/max+1 in standard 2x2 rendering
-    int32_t newX = part.x + (int32_t)part.vx;
-    int32_t newY = part.y + (int32_t)part.vy;
-    partFlags.outofbounds = false; // reset out of bounds (in case particle was created outside the matrix and is now moving into view) note: moving this to checks below adds code and is not faster
-
     if (perParticleSize && advancedproperties != nullptr) { // using individual particle size
       renderradius = PS_P_HALFRADIUS - 1 + advancedproperties->size; // note: single pixel particles should be zero but OOB checks in rendering function handle this
       if (advancedproperties->size > 0)
@@ -250,37 +287,25 @@ void ParticleSystem2D::particleMoveUpdate(PSparticle &part, PSparticleFlags &par
       else // single pixel particles use half the collision distance for walls
         particleHardRadius = PS_P_MINHARDRADIUS >> 1;
     }
-    // note: if wall collisions are enabled, bounce them before they reach the edge, it looks much nicer if the particle does not go half out of view
-    if (options->bounceY) {
-      if ((newY < (int32_t)particleHardRadius) || ((newY > (int32_t)(maxY - particleHardRadius)) && !options->useGravity)) { // reached floor / ceiling
-         bounce(part.vy, part.vx, newY, maxY);
-      }
-    }
-
-    if (!checkBoundsAndWrap(newY, maxY, renderradius, options->wrapY)) { // check out of bounds  note: this must not be skipped. if gravity is enabled, particles will never bounce at the top
-      partFlags.outofbounds = true;
-      if (options->killoutofbounds) {
-        if (newY < 0) // if gravity is enabled, only kill particles below ground
-          part.ttl = 0;
-        else if (!options->useGravity)
-          part.ttl = 0;
-      }
-    }
-
-    if (part.ttl) { //check x direction only if still alive
-      if (options->bounceX) {
-        if ((newX < (int32_t)particleHardRadius) || (newX > (int32_t)(maxX - particleHardRadius))) // reached a wall
-          bounce(part.vx, part.vy, newX, maxX);
-      }
-      else if (!checkBoundsAndWrap(newX, maxX, renderradius, options->wrapX)) { // check out of bounds
-        partFlags.outofbounds = true;
-        if (options->killoutofbounds)
-          part.ttl = 0;
-      }
-    }
+    moveParticle(part, partFlags, *options, renderradius, particleHardRadius);
+  }
+}
 
-    part.x = (int16_t)newX; // set new position
-    part.y = (int16_t)newY; // set new position
+// move, age and kill all used particles using the system settings, same as calling particleMoveUpdate() for each particle
+// settings and limits are loaded once instead of for every particle and dead particles are skipped in a tight loop
+// note: per particle sizes change the hard radius for every particle, those use the per particle function
+void ParticleSystem2D::moveParticles() {
+  if (perParticleSize && advPartProps != nullptr) {
+    for (uint32_t i = 0; i < usedParticles; i++)
+      particleMoveUpdate(particles[i], particleFlags[i], nullptr, &advPartProps[i]);
+    return;
+  }
+  const PSsettings2D options = particlesettings;
+  const int32_t renderradius = PS_P_HALFRADIUS - 1 + particlesize; // see particleMoveUpdate()
+  const int32_t hardRadius = particleHardRadius;
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    if (particles[i].ttl > 0)
+      moveParticle(particles[i], particleFlags[i], options, renderradius, hardRadius);
   }
 }
 
@@ -440,15 +465,17 @@ void ParticleSystem2D::applyForce(const uint32_t particleindex, const int8_t xfo
 
 // apply a force in x,y direction to all particles
 // force is in 3.4 fixed point notation (see above)
+// note: all particles share the global counter so the velocity change is the same for all of them and is calculated once
 void ParticleSystem2D::applyForce(const int8_t xforce, const int8_t yforce) {
-  // for small forces, need to use a delay counter
-  uint8_t tempcounter;
-  // note: this is not the most computationally efficient way to do this, but it saves on duplicate code and is fast enough
-  for (uint32_t i = 0; i < usedParticles; i++) {
-    tempcounter = forcecounter;
-    applyForce(particles[i], xforce, yforce, tempcounter);
+  uint8_t xcounter = forcecounter & 0x0F; // lower four bits
+  uint8_t ycounter = forcecounter >> 4;   // upper four bits
+  const int32_t dvx = calcForce_dv(xforce, xcounter);
+  const int32_t dvy = calcForce_dv(yforce, ycounter);
+  forcecounter = (xcounter & 0x0F) | ((ycounter << 4) & 0xF0); // save counter values back
+  for (uint32_t i = 0; i < usedParticles; i++) { // note: speed is limited even if there is no velocity change, like for single particles
+    particles[i].vx = limitSpeed((int32_t)particles[i].vx + dvx);
+    particles[i].vy = limitSpeed((int32_t)particles[i].vy + dvy);
   }
-  forcecounter = tempcounter; // save value back
 }
 
 // apply a force in angular direction to single particle
@@ -612,7 +639,8 @@ void ParticleSystem2D::render() {
 
   // apply 2D blur to rendered frame
   if (smearBlur) {
-    SEGMENT.blur2D(smearBlur, smearBlur, true);
+    if (smearType == PS_BLUR_SMEAR) SEGMENT.blur2D(smearBlur, smearBlur, true);
+    else SEGMENT.box_blur(1 + (smearBlur >> 6), smearType == PS_BLUR_GAUSSIAN); // radius 1-4
   }
 }
 
@@ -811,83 +839,107 @@ void WLED_O2_ATTR ParticleSystem2D::renderLargeParticle(const uint32_t size, con
   }
 }
 
+uint32_t ParticleSystem2D::collisionChecks = 0;
+
 // detect collisions in an array of particles and handle them
-// uses binning by dividing the frame into slices in x direction which is efficient if using gravity in y direction (but less efficient for FX that use forces in x direction)
-// for code simplicity, no y slicing is done, making very tall matrix configurations less efficient
-// note: also tested adding y slicing, it gives diminishing returns, some FX even get slower. FX not using gravity would benefit with a 10% FPS improvement
+// particles are sorted into a uniform grid of square cells (counting sort, rebuilt every frame) by their look-ahead position (position + velocity)
+// a cell is at least as large as the largest collision distance so particles can only collide with particles in the same or an adjacent cell:
+// each cell is checked against itself and its right, lower left, lower and lower right neighbours, which checks every close pair exactly once
+// the cell size is a power of 2 and is increased until there are no more cells than used particles (+16), which is what the grid in the
+// segment data is sized for (see collisionGridSize2D())
 void ParticleSystem2D::handleCollisions() {
-  uint32_t collDistSq = particleHardRadius << 1; // distance is double the radius note: particleHardRadius is updated when setting global particle size
-  collDistSq = collDistSq * collDistSq; // square it for faster comparison (square is one operation)
-  // note: partices are binned in x-axis, assumption is that no more than half of the particles are in the same bin
-  // if they are, collisionStartIdx is increased so each particle collides at least every second frame (which still gives decent collisions)
-  int binWidth = 6 * PS_P_RADIUS; // width of a bin in sub-pixels
-  int32_t overlap = particleHardRadius << 1; // overlap bins to include edge particles to neighbouring bins
-  if (perParticleSize && advPartProps != nullptr)
-    overlap = 512; // max overlap for collision detection if using per-particle size, enough to catch all particles even at max speed
+  const bool sizePerParticle = perParticleSize && advPartProps != nullptr;
+  const auto collides = [&](uint32_t i) { return particles[i].ttl > 0 && particleFlags[i].outofbounds == 0 && particleFlags[i].collide; }; // alive, in frame and collision enabled
 
-  uint32_t maxBinParticles = max((uint32_t)50, (usedParticles + 1) / 2); // assume no more than half of the particles are in the same bin, do not bin small amounts of particles
-  uint32_t numBins = (maxX + (binWidth - 1)) / binWidth; // number of bins in x direction
-  if (usedParticles < maxBinParticles) {
-    numBins = 1; // use single bin for small number of particles
-    binWidth = maxX + 1;
+  uint32_t count = 0; // number of colliding particles
+  uint32_t maxSize = 0;
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    if (!collides(i)) continue;
+    count++;
+    if (sizePerParticle && advPartProps[i].size > maxSize) maxSize = advPartProps[i].size;
+  }
+  if (count < 2) return;
+
+  // collision distance is double the radius, note: particleHardRadius is updated when setting global particle size
+  uint32_t collDist = sizePerParticle ? (PS_P_MINHARDRADIUS << 1) + ((maxSize * 2 * 52) >> 6) : particleHardRadius << 1; // largest distance of any pair, see below
+  const uint32_t maxCells = usedParticles + 16;
+  uint32_t cellShift = 0;
+  while ((1U << cellShift) < collDist) cellShift++;
+  uint32_t cellsX, cellsY;
+  for (;;) {
+    cellsX = (maxX >> cellShift) + 1;
+    cellsY = (maxY >> cellShift) + 1;
+    if (cellsX * cellsY <= maxCells) break;
+    cellShift++;
+  }
+  const uint32_t numCells = cellsX * cellsY;
+  uint16_t *cellStart = collisionGrid; // particles of cell c are cellParticles[cellStart[c] ... cellStart[c+1]-1]
+  uint16_t *cellParticles = cellStart + numCells + 1;
+
+  const auto cellOf = [&](uint32_t i) {
+    const int32_t x = particles[i].x + particles[i].vx; // look-ahead position, can be slightly out of frame
+    const int32_t y = particles[i].y + particles[i].vy;
+    const uint32_t cx = x < 0 ? 0 : min((uint32_t)x >> cellShift, cellsX - 1);
+    const uint32_t cy = y < 0 ? 0 : min((uint32_t)y >> cellShift, cellsY - 1);
+    return cy * cellsX + cx;
+  };
+  // counting sort: count particles per cell, turn counts into cell end indices and fill cells from their end (which leaves cellStart[c] at the start of cell c)
+  // filling starts at a random particle, so the order in which particles of a cell collide changes every frame (avoids a bias in the collision response)
+  memset(cellStart, 0, (numCells + 1) * sizeof(uint16_t));
+  for (uint32_t i = 0; i < usedParticles; i++) if (collides(i)) cellStart[cellOf(i)]++;
+  for (uint32_t c = 1; c <= numCells; c++) cellStart[c] += cellStart[c - 1];
+  uint32_t pidx = hw_random16(usedParticles);
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    if (collides(pidx)) cellParticles[--cellStart[cellOf(pidx)]] = pidx;
+    if (++pidx >= usedParticles) pidx = 0; // wrap around
   }
-  uint16_t binIndices[maxBinParticles]; // creat array on stack for indices, 2kB max for 1024 particles (ESP32_MAXPARTICLES/2)
-  uint32_t binParticleCount; // number of particles in the current bin
-  uint32_t nextFrameStartIdx = hw_random16(usedParticles); // index of the first particle in the next frame (set to fixed value if bin overflow)
-  uint32_t pidx = collisionStartIdx; //start index in case a bin is full, process remaining particles next frame
 
-  // fill the binIndices array for this bin
-  for (uint32_t bin = 0; bin < numBins; bin++) {
-    binParticleCount = 0; // reset for this bin
-    int32_t binStart = bin * binWidth - overlap; // note: first bin will extend to negative, but that is ok as out of bounds particles are ignored
-    int32_t binEnd = binStart + binWidth + (overlap << 1); // add twice the overlap as start is start-overlap, note: last bin can be out of bounds, see above;
-
-    // fill the binIndices array for this bin
-    for (uint32_t i = 0; i < usedParticles; i++) {
-      if (particles[pidx].ttl > 0) { // is alive
-        if (particles[pidx].x >= binStart && particles[pidx].x <= binEnd) { // >= and <= to include particles on the edge of the bin (overlap to ensure boarder particles collide with adjacent bins)
-          if (particleFlags[pidx].outofbounds == 0 && particleFlags[pidx].collide) { // particle is in frame and does collide note: checking flags is quite slow and usually these are set, so faster to check here
-            if (binParticleCount >= maxBinParticles) { // bin is full, more particles in this bin so do the rest next frame
-              nextFrameStartIdx = pidx; // bin overflow can only happen once as bin size is at least half of the particles (or half +1)
-              break;
-            }
-            binIndices[binParticleCount++] = pidx;
-          }
-        }
-      }
-      pidx++;
-      if (pidx >= usedParticles) pidx = 0; // wrap around
+  uint32_t checks = 0;
+  uint32_t collDistSq = collDist * collDist; // square it for faster comparison (square is one operation)
+  int32_t massratio1 = 0; // 0 means dont use mass ratio (equal mass)
+  int32_t massratio2 = 0; // TODO: if implementing "fixed" particles, set to 1 (fixed) and 255 (movable)
+  const auto checkPair = [&](uint32_t idx_i, uint32_t idx_j) {
+    checks++;
+    if (sizePerParticle) { // using individual particle size
+      collDistSq = (PS_P_MINHARDRADIUS << 1) + ((((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) * 52) >> 6); // collision distance, use 80% of size for tighter stacking (slight overlap)
+      collDistSq = collDistSq * collDistSq; // square it for faster comparison
+      // calculate mass ratio for collision response
+      uint32_t mass1 = PS_P_RADIUS + advPartProps[idx_i].size;
+      uint32_t mass2 = PS_P_RADIUS + advPartProps[idx_j].size;
+      mass1 = mass1 * mass1; // mass proportional to area
+      mass2 = mass2 * mass2;
+      uint32_t totalmass = mass1 + mass2;
+      massratio1 = (mass2 << 8) / totalmass; // massratio 1 depends on mass of particle 2, i.e. if 2 is heavier -> higher velocity impact on 1
+      massratio2 = (mass1 << 8) / totalmass;
     }
-
-    int32_t massratio1 = 0; // 0 means dont use mass ratio (equal mass)
-    int32_t massratio2 = 0; // TODO: if implementing "fixed" particles, set to 1 (fixed) and 255 (movable)
-    for (uint32_t i = 0; i < binParticleCount; i++) { // go though all 'higher number' particles in this bin and see if any of those are in close proximity and if they are, make them collide
-      uint32_t idx_i = binIndices[i];
-      for (uint32_t j = i + 1; j < binParticleCount; j++) { // check against higher number particles
-        uint32_t idx_j = binIndices[j];
-        if (perParticleSize && advPartProps != nullptr) { // using individual particle size
-          collDistSq = (PS_P_MINHARDRADIUS << 1) + ((((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) * 52) >> 6); // collision distance, use 80% of size for tighter stacking (slight overlap)
-          collDistSq = collDistSq * collDistSq; // square it for faster comparison
-          // calculate mass ratio for collision response
-          uint32_t mass1 = PS_P_RADIUS + advPartProps[idx_i].size;
-          uint32_t mass2 = PS_P_RADIUS + advPartProps[idx_j].size;
-          mass1 = mass1 * mass1; // mass proportional to area
-          mass2 = mass2 * mass2;
-          uint32_t totalmass = mass1 + mass2;
-          massratio1 = (mass2 << 8) / totalmass; // massratio 1 depends on mass of particle 2, i.e. if 2 is heavier -> higher velocity impact on 1
-          massratio2 = (mass1 << 8) / totalmass;
-        }
-        // note: using the same logic as in 1D is much slower though it would be more accurate but it is not really needed in 2D: particles slipping through each other is much less visible
-        int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance with lookahead
-        if (dx * dx < collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
-          int32_t dy = (particles[idx_j].y + particles[idx_j].vy)  - (particles[idx_i].y + particles[idx_i].vy); // distance with lookahead
-          if (dy * dy < collDistSq) // particles are close
-            collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq, massratio1, massratio2);
-        }
+    // note: using the same logic as in 1D is much slower though it would be more accurate but it is not really needed in 2D: particles slipping through each other is much less visible
+    int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance with lookahead
+    if (dx * dx < collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
+      int32_t dy = (particles[idx_j].y + particles[idx_j].vy) - (particles[idx_i].y + particles[idx_i].vy); // distance with lookahead
+      if (dy * dy < collDistSq) // particles are close
+        collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq, massratio1, massratio2);
+    }
+  };
+
+  for (uint32_t cy = 0; cy < cellsY; cy++) {
+    for (uint32_t cx = 0; cx < cellsX; cx++) {
+      const uint32_t cell = cy * cellsX + cx;
+      const uint32_t cellEnd = cellStart[cell + 1];
+      // particles of the right neighbour follow the ones of this cell, the three lower neighbours are consecutive as well
+      const uint32_t sameRowEnd = (cx + 1 < cellsX) ? cellStart[cell + 2] : cellEnd;
+      uint32_t belowStart = 0, belowEnd = 0;
+      if (cy + 1 < cellsY) {
+        belowStart = cellStart[cell + cellsX - (cx > 0)];
+        belowEnd   = cellStart[cell + cellsX + (cx + 1 < cellsX) + 1];
+      }
+      for (uint32_t a = cellStart[cell]; a < cellEnd; a++) {
+        const uint32_t idx_i = cellParticles[a];
+        for (uint32_t b = a + 1; b < sameRowEnd; b++) checkPair(idx_i, cellParticles[b]);
+        for (uint32_t b = belowStart; b < belowEnd; b++) checkPair(idx_i, cellParticles[b]);
       }
     }
   }
-  collisionStartIdx = nextFrameStartIdx; // set the start index for the next frame
+  collisionChecks += checks;
 }
 
 // handle a collision if close proximity is detected, i.e. dx and/or dy smaller than 2*PS_P_RADIUS
@@ -1012,6 +1064,19 @@ void WLED_O2_ATTR ParticleSystem2D::collideParticles(PSparticle &particle1, PSpa
 
 // update size and pointers (memory location and size can change dynamically)
 // note: do not access the PS class in FX befor running this function (or it messes up SEGENV.data)
+// the segment data (with the PS at its start) was moved by offset bytes, i.e. by compaction of the data arena
+// the pointers into it are fixed right away so they are valid even before the next updateSystem()
+void ParticleSystem2D::relocate(uint8_t *data, ptrdiff_t offset) {
+  ParticleSystem2D *ps = reinterpret_cast<ParticleSystem2D *>(data);
+  shiftPointer(ps->particles, offset);
+  shiftPointer(ps->particleFlags, offset);
+  shiftPointer(ps->sources, offset);
+  shiftPointer(ps->advPartProps, offset);
+  shiftPointer(ps->advPartSize, offset);
+  shiftPointer(ps->PSdataEnd, offset);
+  shiftPointer(ps->collisionGrid, offset); // framebuffer is the segment's pixel buffer
+}
+
 void ParticleSystem2D::updateSystem(void) {
   //PSPRINTLN("updateSystem2D");
   setMatrixSize(SEGMENT.vWidth(), SEGMENT.vHeight());
@@ -1041,6 +1106,8 @@ void ParticleSystem2D::updatePSpointers(bool isadvanced, bool sizecontrol) {
       PSdataEnd = reinterpret_cast<uint8_t *>(advPartSize + numParticles);
     }
   }
+  collisionGrid = reinterpret_cast<uint16_t *>(PSdataEnd);
+  PSdataEnd += collisionGridSize2D(numParticles);
 #ifdef DEBUG_PS
   Serial.printf_P(PSTR(" particles %p "), particles);
   Serial.printf_P(PSTR(" sources %p "), sources);
@@ -1087,6 +1154,7 @@ bool allocateParticleSystemMemory2D(uint32_t numparticles, uint32_t numsources,
   if (sizecontrol)
     requiredmemory += sizeof(PSsizeControl) * numparticles;
   requiredmemory += sizeof(PSsource) * numsources;
+  requiredmemory += collisionGridSize2D(numparticles);
   requiredmemory += additionalbytes;
   return(SEGMENT.allocateData(requiredmemory));
 }
@@ -1125,6 +1193,7 @@ bool initParticleSystem2D(ParticleSystem2D *&PartSys, uint32_t requestedsources,
   }
 
   PartSys = new (SEGENV.data) ParticleSystem2D(cols, rows, numparticles, numsources, advanced, sizecontrol); // particle system constructor
+  SEGMENT.setDataRelocator(ParticleSystem2D::relocate); // PS keeps pointers into the segment data
 
   PSPRINTLN(F("2D PS init done"));
   return true;
@@ -1179,10 +1248,7 @@ void ParticleSystem1D::update(void) {
       handleCollisions(); // second pass for per particle size (as impulse transfer can recoil at high speed, this improves "slip through" issues for small particles but is expensive)
   }
 
-  //move all particles
-  for (uint32_t i = 0; i < usedParticles; i++) {
-    particleMoveUpdate(particles[i], particleFlags[i], nullptr, advPartProps ? &advPartProps[i] : nullptr);
-  }
+  moveParticles(); //move all particles
 
   if (particlesettings.colorByPosition) {
     uint32_t scale = (255 << 16) / maxX;
@@ -1293,6 +1359,64 @@ int32_t ParticleSystem1D::sprayEmit(const PSsource1D &emitter) {
   return -1;
 }
 
+// move, age and kill one living particle, shared by particleMoveUpdate() and moveParticles()
+// renderradius is used to check out of bounds, hardRadius is the distance at which particles bounce off walls
+inline void ParticleSystem1D::moveParticle(PSparticle1D &part, PSparticleFlags1D &partFlags, const PSsettings1D &options, const int32_t renderradius, const int32_t hardRadius) {
+  if (!partFlags.perpetual)
+    part.ttl--; // age
+  if (options.colorByAge)
+    part.hue = min(part.ttl, (uint16_t)255); // set color to ttl
+
+  int32_t newX = part.x + (int32_t)part.vx;
+  partFlags.outofbounds = false; // reset out of bounds (in case particle was created outside the matrix and is now moving into view)
+
+  // if wall collisions are enabled, bounce them before they reach the edge, it looks much nicer if the particle is not half out of view
+  if (options.bounce) {
+    if ((newX < hardRadius) || (newX > maxX - hardRadius)) { // reached a wall
+      bool bouncethis = true;
+      if (options.useGravity) {
+        if (partFlags.reversegrav) { // skip bouncing at x = 0
+          if (newX < hardRadius)
+            bouncethis = false;
+        } else if (newX > hardRadius) { // skip bouncing at x = max
+          bouncethis = false;
+        }
+      }
+      if (bouncethis) {
+        part.vx = -part.vx; // invert speed
+        part.vx = ((int32_t)part.vx * (int32_t)wallHardness) / 255; // reduce speed as energy is lost on non-hard surface
+        if (newX < hardRadius)
+          newX = hardRadius; // fast particles will never reach the edge if position is inverted, this looks better
+        else
+          newX = maxX - hardRadius;
+      }
+    }
+  }
+
+  if (!checkBoundsAndWrap(newX, maxX, renderradius, options.wrap)) { // check out of bounds note: this must not be skipped or it can lead to crashes
+    partFlags.outofbounds = true;
+    if (options.killoutofbounds) {
+      bool killthis = true;
+      if (options.useGravity) { // if gravity is used, only kill below 'floor level'
+        if (partFlags.reversegrav) { // skip at x = 0, do not skip far out of bounds
+          if (newX < 0 || newX > maxX << 2)
+            killthis = false;
+        } else { // skip at x = max, do not skip far out of bounds
+          if (newX > 0 &&  newX < maxX << 2)
+            killthis = false;
+        }
+      }
+      if (killthis)
+        part.ttl = 0;
+    }
+  }
+
+  if (!partFlags.fixed)
+    part.x = newX; // set new position
+  else
+    part.vx = 0; // set speed to zero. note: particle can get speed in collisions, if unfixed, it should not speed away
+}
+
 // particle moves, decays and dies, if killoutofbounds is set, out of bounds particles are set to ttl=0
 // uses passed settings to set bounce or wrap, if useGravity is set, it will never bounce at the top and killoutofbounds is not applied over the top
 void ParticleSystem1D::particleMoveUpdate(PSparticle1D &part, PSparticleFlags1D &partFlags, PSsettings1D *options, PSadvancedParticle1D *advancedproperties) {
@@ -1300,15 +1424,7 @@ void ParticleSystem1D::particleMoveUpdate(PSparticle1D &part, PSparticleFlags1D
     options = &particlesettings; // use PS system settings by default
 
   if (part.ttl > 0) {
-    if (!partFlags.perpetual)
-      part.ttl--; // age
-    if (options->colorByAge)
-      part.hue = min(part.ttl, (uint16_t)255); // set color to ttl
-
     int32_t renderradius = PS_P_HALFRADIUS_1D - 1 + particlesize; // used to check out of bounds, default for 2 pixel rendering
-    int32_t newX = part.x + (int32_t)part.vx;
-    partFlags.outofbounds = false; // reset out of bounds (in case particle was created outside the matrix and is now moving into view)
-
     if (perParticleSize && advancedproperties != nullptr) { // using individual particle size?
       renderradius = PS_P_HALFRADIUS_1D - 1 + advancedproperties->size; // note: for single pixel particles, it should be zero, but it does not matter as out of bounds checking is done in rendering function
       if (advancedproperties->size > 1)
@@ -1316,52 +1432,25 @@ void ParticleSystem1D::particleMoveUpdate(PSparticle1D &part, PSparticleFlags1D
       else // single pixel particles use half the collision distance for walls
         particleHardRadius = PS_P_MINHARDRADIUS_1D >> 1;
     }
+    moveParticle(part, partFlags, *options, renderradius, particleHardRadius);
+  }
+}
 
-    // if wall collisions are enabled, bounce them before they reach the edge, it looks much nicer if the particle is not half out of view
-    if (options->bounce) {
-      if ((newX < (int32_t)particleHardRadius) || ((newX > (int32_t)(maxX - particleHardRadius)))) { // reached a wall
-        bool bouncethis = true;
-        if (options->useGravity) {
-          if (partFlags.reversegrav) { // skip bouncing at x = 0
-            if (newX < (int32_t)particleHardRadius)
-              bouncethis = false;
-          } else if (newX > (int32_t)particleHardRadius) { // skip bouncing at x = max
-            bouncethis = false;
-          }
-        }
-        if (bouncethis) {
-          part.vx = -part.vx; // invert speed
-          part.vx = ((int32_t)part.vx * (int32_t)wallHardness) / 255; // reduce speed as energy is lost on non-hard surface
-          if (newX < (int32_t)particleHardRadius)
-            newX = particleHardRadius; // fast particles will never reach the edge if position is inverted, this looks better
-          else
-            newX = maxX - particleHardRadius;
-        }
-      }
-    }
-
-    if (!checkBoundsAndWrap(newX, maxX, renderradius, options->wrap)) { // check out of bounds note: this must not be skipped or it can lead to crashes
-      partFlags.outofbounds = true;
-      if (options->killoutofbounds) {
-        bool killthis = true;
-        if (options->useGravity) { // if gravity is used, only kill below 'floor level'
-          if (partFlags.reversegrav) { // skip at x = 0, do not skip far out of bounds
-            if (newX < 0 || newX > maxX << 2)
-              killthis = false;
-          } else { // skip at x = max, do not skip far out of bounds
-            if (newX > 0 &&  newX < maxX << 2)
-              killthis = false;
-          }
-        }
-        if (killthis)
-          part.ttl = 0;
-      }
-    }
-
-    if (!partFlags.fixed)
-      part.x = newX; // set new position
-    else
-      part.vx = 0; // set speed to zero. note: particle can get speed in collisions, if unfixed, it should not speed away
+// move, age and kill all used particles using the system settings, same as calling particleMoveUpdate() for each particle
+// settings and limits are loaded once instead of for every particle and dead particles are skipped in a tight loop
+// note: per particle sizes change the hard radius for every particle, those use the per particle function
+void ParticleSystem1D::moveParticles() {
+  if (perParticleSize && advPartProps != nullptr) {
+    for (uint32_t i = 0; i < usedParticles; i++)
+      particleMoveUpdate(particles[i], particleFlags[i], nullptr, &advPartProps[i]);
+    return;
+  }
+  const PSsettings1D options = particlesettings;
+  const int32_t renderradius = PS_P_HALFRADIUS_1D - 1 + particlesize; // see particleMoveUpdate()
+  const int32_t hardRadius = particleHardRadius;
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    if (particles[i].ttl > 0)
+      moveParticle(particles[i], particleFlags[i], options, renderradius, hardRadius);
   }
 }
 
@@ -1759,6 +1848,18 @@ void WLED_O2_ATTR ParticleSystem1D::collideParticles(uint32_t partIdx1, uint32_t
 
 // update size and pointers (memory location and size can change dynamically)
 // note: do not access the PS class in FX befor running this function (or it messes up SEGENV.data)
+// the segment data (with the PS at its start) was moved by offset bytes, see ParticleSystem2D::relocate()
+void ParticleSystem1D::relocate(uint8_t *data, ptrdiff_t offset) {
+  ParticleSystem1D *ps = reinterpret_cast<ParticleSystem1D *>(data);
+  const bool localBuffer = reinterpret_cast<uint8_t *>(ps->framebuffer) == reinterpret_cast<uint8_t *>(ps->sources + ps->numSources); // 1D->2D mapping buffer
+  shiftPointer(ps->particles, offset);
+  shiftPointer(ps->particleFlags, offset);
+  shiftPointer(ps->sources, offset);
+  shiftPointer(ps->advPartProps, offset);
+  shiftPointer(ps->PSdataEnd, offset);
+  if (localBuffer) shiftPointer(ps->framebuffer, offset);
+}
+
 void ParticleSystem1D::updateSystem(void) {
   setSize(SEGMENT.vLength()); // update size
   updatePSpointers(advPartProps != nullptr);
@@ -1866,6 +1967,7 @@ bool initParticleSystem1D(ParticleSystem1D *&PartSys, const uint32_t requestedso
     return false; // allocation failed
   }
   PartSys = new (SEGENV.data) ParticleSystem1D(SEGMENT.virtualLength(), numparticles, numsources, advanced); // particle system constructor
+  SEGMENT.setDataRelocator(ParticleSystem1D::relocate); // PS keeps pointers into the segment data
   return true;
 }
 #endif // WLED_DISABLE_PARTICLESYSTEM1D
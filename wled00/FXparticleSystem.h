@@ -62,6 +62,11 @@ static inline int32_t limitSpeed(const int32_t speed) {
 #define PS_P_MINHARDRADIUS 64 // minimum hard surface radius for collisions
 #define PS_P_MINSURFACEHARDNESS 128 // minimum hardness used in collision impulse calculation, below this hardness, particles become sticky
 
+// full frame blur types for setSmearBlur()
+#define PS_BLUR_SMEAR 0 // carry blur without fading (blur2D() smear)
+#define PS_BLUR_BOX 1 // box blur, radius 1-4 depending on blur amount
+#define PS_BLUR_GAUSSIAN 2 // 3-pass box blur approximating a gaussian blur
+
 // struct for PS settings (shared for 1D and 2D class)
 typedef union {
   struct{ // one byte bit field for 2D settings
@@ -78,6 +83,8 @@ typedef union {
 } PSsettings2D;
 
 //struct for a single particle
+// particles are stored as an array of structs: effects index particles[i] directly and pass PSparticle references to the
+// per-particle functions, the batch kernels (moveParticles(), applyForce(), applyGravity(), applyFriction()) loop over the array
 typedef struct { // 10 bytes
   int16_t x;  // x position in particle system
   int16_t y;  // y position in particle system
@@ -147,6 +154,7 @@ public:
   void update(void); //update the particles according to set options and render to the matrix
   void updateFire(const uint8_t intensity); // update function for fire
   void updateSystem(void); // call at the beginning of every FX, updates pointers and dimensions
+  static void relocate(uint8_t *data, ptrdiff_t offset); // Segment::DataRelocator, adjusts the pointers after the segment data moved
   void particleMoveUpdate(PSparticle &part, PSparticleFlags &partFlags, PSsettings2D *options = NULL, PSadvancedParticle *advancedproperties = NULL); // move function
   // particle emitters
   int32_t sprayEmit(const PSsource &emitter);
@@ -177,7 +185,7 @@ public:
   void setSaturation(const uint8_t sat); // set global color saturation
   void setColorByAge(const bool enable);
   void setMotionBlur(const uint8_t bluramount); // note: motion blur can only be used if 'particlesize' is set to zero
-  void setSmearBlur(const uint8_t bluramount); // enable 2D smeared blurring of full frame
+  void setSmearBlur(const uint8_t bluramount, const uint8_t blurtype = PS_BLUR_SMEAR); // enable 2D blurring of full frame (smear or box/gaussian with radius 1-4)
   void setParticleSize(const uint8_t size);
   void setGravity(const int8_t force = 8);
   void enableParticleCollisions(const bool enable, const uint8_t hardness = 255);
@@ -194,6 +202,7 @@ public:
   uint32_t usedParticles; // number of particles used in animation, is relative to 'numParticles'
   bool perParticleSize; // if true, uses individual particle sizes from advPartProps if available (disabled when calling setParticleSize())
   //note: some variables are 32bit for speed and code size at the cost of ram
+  static uint32_t collisionChecks; // number of particle pairs checked for collisions by all 2D systems (for benchmarking, never reset by the system)
 
 private:
   //rendering functions
@@ -202,6 +211,8 @@ private:
   void renderLargeParticle(const uint32_t size, const uint32_t particleindex, const uint8_t brightness, const CRGBW& color, const bool wrapX, const bool wrapY);
   //paricle physics applied by system if flags are set
   void applyGravity(); // applies gravity to all particles
+  void moveParticles(); // applies particleMoveUpdate() to all particles
+  [[gnu::hot]] inline void moveParticle(PSparticle &part, PSparticleFlags &partFlags, const PSsettings2D &options, const int32_t renderradius, const int32_t hardRadius);
   void handleCollisions();
   void collideParticles(PSparticle &particle1, PSparticle &particle2, int32_t dx, int32_t dy, const uint32_t collDistSq, int32_t massratio1, int32_t massratio2);
   void fireParticleupdate();
@@ -212,6 +223,7 @@ private:
   [[gnu::hot]] void bounce(int8_t &incomingspeed, int8_t &parallelspeed, int32_t &position, const uint32_t maxposition); // bounce on a wall
   // note: variables that are accessed often are 32bit for speed
   uint32_t *framebuffer; // frame buffer for rendering. note: using CRGBW as the buffer is slower, ESP compiler seems to optimize this better giving more consistent FPS
+  uint16_t *collisionGrid; // cells for collision detection, in the segment data after the particles (see handleCollisions())
   PSsettings2D particlesettings; // settings used when updating particles (can also used by FX to move sources), do not edit properties directly, use functions above
   uint32_t numParticles;  // total number of particles allocated by this system
   uint32_t emitIndex; // index to count through particles to emit so searching for dead pixels is faster
@@ -219,7 +231,6 @@ private:
   uint32_t wallHardness;
   uint32_t wallRoughness; // randomizes wall collisions
   uint32_t particleHardRadius; // hard surface radius of a particle, used for collision detection (32bit for speed)
-  uint16_t collisionStartIdx; // particle array start index for collision detection
   uint8_t fireIntesity = 0; // fire intensity, used for fire mode (flash use optimization, better than passing an argument to render function)
   uint8_t forcecounter; // counter for globally applied forces
   uint8_t gforcecounter; // counter for global gravity
@@ -228,6 +239,7 @@ private:
   uint8_t particlesize; // global particle size, 0 = 1 pixel, 1 = 2 pixels, 255 = 10 pixels (note: this is also added to individual sized particles, set to 0 or 1 for standard advanced particle rendering)
   uint8_t motionBlur; // motion blur, values > 100 gives smoother animations. Note: motion blurring does not work if particlesize is > 0
   uint8_t smearBlur; // 2D smeared blurring of full frame
+  uint8_t smearType; // PS_BLUR_SMEAR, PS_BLUR_BOX or PS_BLUR_GAUSSIAN
 };
 
 // initialization functions (not part of class)
@@ -344,6 +356,7 @@ public:
   // note: memory is allcated in the FX function, no deconstructor needed
   void update(void); //update the particles according to set options and render to the matrix
   void updateSystem(void); // call at the beginning of every FX, updates pointers and dimensions
+  static void relocate(uint8_t *data, ptrdiff_t offset); // Segment::DataRelocator, adjusts the pointers after the segment data moved
   // particle emitters
   int32_t sprayEmit(const PSsource1D &emitter);
   void particleMoveUpdate(PSparticle1D &part, PSparticleFlags1D &partFlags, PSsettings1D *options = NULL, PSadvancedParticle1D *advancedproperties = NULL); // move function
@@ -389,6 +402,8 @@ private:
 
   //paricle physics applied by system if flags are set
   void applyGravity(); // applies gravity to all particles
+  void moveParticles(); // applies particleMoveUpdate() to all particles
+  [[gnu::hot]] inline void moveParticle(PSparticle1D &part, PSparticleFlags1D &partFlags, const PSsettings1D &options, const int32_t renderradius, const int32_t hardRadius);
   void handleCollisions();
   void collideParticles(uint32_t partIdx1, uint32_t partIdx2, int32_t dx, uint32_t collisiondistance);
 
@@ -0,0 +1,167 @@
+/*
+ * Bus functions that do not depend on an output driver: color order, white and CCT calculation and
+ * routing of pixels to buses. Kept apart from bus_manager.cpp so that the host-native FX benchmark
+ * (tools/native_bench) compiles the same code as the firmware.
+ */
+
+#include "wled.h"
+
+bool ColorOrderMap::add(uint16_t start, uint16_t len, uint8_t colorOrder) {
+  if (count() >= WLED_MAX_COLOR_ORDER_MAPPINGS || len == 0 || (colorOrder & 0x0F) > COL_ORDER_MAX) return false; // upper nibble contains W swap information
+  _mappings.push_back({start,len,colorOrder});
+  DEBUGBUS_PRINTF_P(PSTR("Bus: Add COM (%d,%d,%d)\n"), (int)start, (int)len, (int)colorOrder);
+  return true;
+}
+
+uint8_t IRAM_ATTR ColorOrderMap::getPixelColorOrder(uint16_t pix, uint8_t defaultColorOrder) const {
+  // upper nibble contains W swap information
+  // when ColorOrderMap's upper nibble contains value >0 then swap information is used from it, otherwise global swap is used
+  for (const auto& map : _mappings) {
+    if (pix >= map.start && pix < (map.start + map.len)) return map.colorOrder | ((map.colorOrder >> 4) ? 0 : (defaultColorOrder & 0xF0));
+  }
+  return defaultColorOrder;
+}
+
+
+void Bus::calculateCCT(uint32_t c, uint8_t &ww, uint8_t &cw) {
+  unsigned cct = 0; //0 - full warm white, 255 - full cold white
+  unsigned w = W(c);
+
+  if (_cct > -1) {                                    // using RGB?
+    if (_cct >= 1900)    cct = (_cct - 1900) >> 5;    // convert K in relative format
+    else if (_cct < 256) cct = _cct;                  // already relative
+  } else {
+    cct = (approximateKelvinFromRGB(c) - 1900) >> 5;  // convert K (from RGB value) to relative format
+  }
+
+  // CCT blending modes (_cctBlend):
+  // blend<0: ww: ▓▓▒░__  | blend=0: ww: ▓▒▒░░ |  blend>0 ww: ▓▓▓▒░
+  //          cw: __░▒▓▓  |          cw: ░░▒▒▓ |          cw: ░▒▓▓▓
+  int32_t ww_val, cw_val;
+  if (_cctBlend < 0) {
+    uint16_t range = 255 - 2 * (uint16_t)(-_cctBlend);
+    if (range > 255) range = 255; // prevent overflow
+    ww_val = range ? ((int32_t)(255 + _cctBlend - cct) * 255) / range : (cct < 128 ? 255 : 0); // exclusive blending
+    cw_val = 255 - ww_val;
+  } else {
+    ww_val = _cctBlend ? ((int32_t)(255 - cct) * 255) / (255 - _cctBlend) : 255 - cct; // additive blending
+    cw_val = _cctBlend ? ((int32_t) cct      * 255) / (255 - _cctBlend) : cct;
+  }
+  ww = (uint8_t)(ww_val < 0 ? 0 : ww_val > 255 ? 255 : ww_val);
+  cw = (uint8_t)(cw_val < 0 ? 0 : cw_val > 255 ? 255 : cw_val);
+
+  ww = (w * ww) / 255; //brightness scaling
+  cw = (w * cw) / 255;
+}
+
+// calculates white channel and CCT values based on given settings
+uint32_t Bus::autoWhiteCalc(uint32_t c, uint8_t &ww, uint8_t &cw) const {
+  unsigned aWM = _autoWhiteMode;
+  if (_gAWM < AW_GLOBAL_DISABLED) aWM = _gAWM;
+  CRGBW cIn = c; // save original color for CCT calculation
+  unsigned w = W(c);
+  if (aWM != RGBW_MODE_MANUAL_ONLY) {
+    unsigned r = R(c); // note: using uint8_t generates larger code
+    unsigned g = G(c);
+    unsigned b = B(c);
+    if (aWM == RGBW_MODE_DUAL && w > 0) {
+      //ignore auto-white calculation if w>0 and mode DUAL (DUAL behaves as BRIGHTER if w==0)
+    } else if (aWM == RGBW_MODE_MAX) {
+      w = r > g ? (r > b ? r : b) : (g > b ? g : b); // brightest RGB channel
+    } else {
+      w = r < g ? (r < b ? r : b) : (g < b ? g : b); // darkest RGB channel
+      if (aWM == RGBW_MODE_AUTO_ACCURATE) { r -= w; g -= w; b -= w; } //subtract w in ACCURATE mode
+    }
+    c = RGBW32(r, g, b, w);
+  }
+  if (_hasCCT) {
+    cIn.w = w; // need original rgb values in case CCT is derived from RGB
+    calculateCCT(cIn, ww, cw);
+  }
+  return c;
+}
+
+// bulk write for buses without their own implementation, colors are gamma corrected here while a frame is written
+void Bus::setPixelColors(unsigned start, const uint32_t *c, size_t len) {
+  if (_gamma) for (size_t i = 0; i < len; i++) setPixelColor(start + i, gamma32(c[i]));
+  else        for (size_t i = 0; i < len; i++) setPixelColor(start + i, c[i]);
+}
+
+// build a table of pixel ranges sorted by start so that show() can hand whole runs to each bus
+// instead of testing every bus for every pixel; placeholders and empty buses are left out
+void BusManager::rebuildRoutes() {
+  _routes.clear();
+  for (const auto &bus : busses) {
+    if (bus->isPlaceholder() || bus->getLength() == 0) continue;
+    _routes.push_back({bus->getStart(), (uint16_t)(bus->getStart() + bus->getLength()), bus.get()});
+  }
+  std::stable_sort(_routes.begin(), _routes.end(), [](const BusRoute &a, const BusRoute &b) { return a.start < b.start; });
+  _routesOverlap = false;
+  unsigned maxEnd = 0;
+  for (const auto &r : _routes) {
+    if (r.start < maxEnd) _routesOverlap = true;
+    maxEnd = std::max(maxEnd, (unsigned)r.end);
+  }
+  DEBUGBUS_PRINTF_P(PSTR("Bus: %u routes%s\n"), (unsigned)_routes.size(), _routesOverlap ? " (overlapping)" : "");
+}
+
+void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
+  if (_routesOverlap) {
+    // a pixel may be driven by several buses, all of them need to be updated
+    for (const auto &r : _routes) if (pix >= r.start && pix < r.end) r.bus->setPixelColor(pix - r.start, c);
+    return;
+  }
+  // routes are disjoint and sorted: find last route starting at or before pix
+  size_t lo = 0, hi = _routes.size();
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (_routes[mid].start <= pix) lo = mid + 1; else hi = mid;
+  }
+  if (lo == 0) return;
+  const BusRoute &r = _routes[lo-1];
+  if (pix < r.end) r.bus->setPixelColor(pix - r.start, c);
+}
+
+// pixels [start, start+len) are consecutive physical pixels; each bus receives its part of the run in one call
+void IRAM_ATTR BusManager::setPixelColors(unsigned start, const uint32_t *c, size_t len) {
+  const unsigned end = start + len;
+  for (const auto &r : _routes) {
+    if (r.start >= end) break; // routes are sorted by start
+    if (r.end <= start) continue;
+    const unsigned from = std::max(start, (unsigned)r.start);
+    const unsigned to   = std::min(end, (unsigned)r.end);
+    r.bus->setPixelColors(from - r.start, c + (from - start), to - from);
+  }
+}
+
+void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
+  if (cct > 255) cct = 255;
+  if (cct >= 0) {
+    //if white balance correction allowed, save as kelvin value instead of 0-255
+    if (allowWBCorrection) cct = 1900 + (cct << 5);
+  } else cct = -1; // will use kelvin approximation from RGB
+  Bus::setCCT(cct);
+}
+
+uint32_t BusManager::getPixelColor(unsigned pix) {
+  for (auto &bus : busses) {
+    if (!bus->containsPixel(pix)) continue;
+    return bus->getPixelColor(pix - bus->getStart());
+  }
+  return 0;
+}
+
+// Bus static member definition
+int16_t Bus::_cct = -1;     // -1 means use approximateKelvinFromRGB(), 0-255 is standard, >1900 use colorBalanceFromKelvin()
+int8_t  Bus::_cctBlend = 0; // -128 to +127
+uint8_t Bus::_gAWM = 255;
+bool    Bus::_gamma = false;
+
+std::vector<std::unique_ptr<Bus>> BusManager::busses;
+std::vector<BusRoute> BusManager::_routes;
+bool BusManager::_routesOverlap = false;
+uint16_t BusManager::_gMilliAmpsUsed = 0;
+uint16_t BusManager::_gMilliAmpsPredicted = 0;
+uint16_t BusManager::_gMilliAmpsMax = ABL_MILLIAMPS_DEFAULT;
+bool BusManager::_useABL = false;
+bool BusManager::_ablPredicted = false;
@@ -50,82 +50,6 @@ static inline void setBitArray(uint8_t* byteArray, size_t numBits, bool value) {
 
 static ColorOrderMap _colorOrderMap = {};
 
-bool ColorOrderMap::add(uint16_t start, uint16_t len, uint8_t colorOrder) {
-  if (count() >= WLED_MAX_COLOR_ORDER_MAPPINGS || len == 0 || (colorOrder & 0x0F) > COL_ORDER_MAX) return false; // upper nibble contains W swap information
-  _mappings.push_back({start,len,colorOrder});
-  DEBUGBUS_PRINTF_P(PSTR("Bus: Add COM (%d,%d,%d)\n"), (int)start, (int)len, (int)colorOrder);
-  return true;
-}
-
-uint8_t IRAM_ATTR ColorOrderMap::getPixelColorOrder(uint16_t pix, uint8_t defaultColorOrder) const {
-  // upper nibble contains W swap information
-  // when ColorOrderMap's upper nibble contains value >0 then swap information is used from it, otherwise global swap is used
-  for (const auto& map : _mappings) {
-    if (pix >= map.start && pix < (map.start + map.len)) return map.colorOrder | ((map.colorOrder >> 4) ? 0 : (defaultColorOrder & 0xF0));
-  }
-  return defaultColorOrder;
-}
-
-
-void Bus::calculateCCT(uint32_t c, uint8_t &ww, uint8_t &cw) {
-  unsigned cct = 0; //0 - full warm white, 255 - full cold white
-  unsigned w = W(c);
-
-  if (_cct > -1) {                                    // using RGB?
-    if (_cct >= 1900)    cct = (_cct - 1900) >> 5;    // convert K in relative format
-    else if (_cct < 256) cct = _cct;                  // already relative
-  } else {
-    cct = (approximateKelvinFromRGB(c) - 1900) >> 5;  // convert K (from RGB value) to relative format
-  }
-
-  // CCT blending modes (_cctBlend):
-  // blend<0: ww: ▓▓▒░__  | blend=0: ww: ▓▒▒░░ |  blend>0 ww: ▓▓▓▒░
-  //          cw: __░▒▓▓  |          cw: ░░▒▒▓ |          cw: ░▒▓▓▓
-  int32_t ww_val, cw_val;
-  if (_cctBlend < 0) {
-    uint16_t range = 255 - 2 * (uint16_t)(-_cctBlend);
-    if (range > 255) range = 255; // prevent overflow
-    ww_val = range ? ((int32_t)(255 + _cctBlend - cct) * 255) / range : (cct < 128 ? 255 : 0); // exclusive blending
-    cw_val = 255 - ww_val;
-  } else {
-    ww_val = _cctBlend ? ((int32_t)(255 - cct) * 255) / (255 - _cctBlend) : 255 - cct; // additive blending
-    cw_val = _cctBlend ? ((int32_t) cct      * 255) / (255 - _cctBlend) : cct;
-  }
-  ww = (uint8_t)(ww_val < 0 ? 0 : ww_val > 255 ? 255 : ww_val);
-  cw = (uint8_t)(cw_val < 0 ? 0 : cw_val > 255 ? 255 : cw_val);
-
-  ww = (w * ww) / 255; //brightness scaling
-  cw = (w * cw) / 255;
-}
-
-// calculates white channel and CCT values based on given settings
-uint32_t Bus::autoWhiteCalc(uint32_t c, uint8_t &ww, uint8_t &cw) const {
-  unsigned aWM = _autoWhiteMode;
-  if (_gAWM < AW_GLOBAL_DISABLED) aWM = _gAWM;
-  CRGBW cIn = c; // save original color for CCT calculation
-  unsigned w = W(c);
-  if (aWM != RGBW_MODE_MANUAL_ONLY) {
-    unsigned r = R(c); // note: using uint8_t generates larger code
-    unsigned g = G(c);
-    unsigned b = B(c);
-    if (aWM == RGBW_MODE_DUAL && w > 0) {
-      //ignore auto-white calculation if w>0 and mode DUAL (DUAL behaves as BRIGHTER if w==0)
-    } else if (aWM == RGBW_MODE_MAX) {
-      w = r > g ? (r > b ? r : b) : (g > b ? g : b); // brightest RGB channel
-    } else {
-      w = r < g ? (r < b ? r : b) : (g < b ? g : b); // darkest RGB channel
-      if (aWM == RGBW_MODE_AUTO_ACCURATE) { r -= w; g -= w; b -= w; } //subtract w in ACCURATE mode
-    }
-    c = RGBW32(r, g, b, w);
-  }
-  if (_hasCCT) {
-    cIn.w = w; // need original rgb values in case CCT is derived from RGB
-    calculateCCT(cIn, ww, cw);
-  }
-  return c;
-}
-
-
 BusDigital::BusDigital(const BusConfig &bc)
 : Bus(bc.type, bc.start, bc.autoWhite, bc.count, bc.reversed, (bc.refreshReq || bc.type == TYPE_TM1814))
 , _skip(bc.skipAmount) //sacrificial pixels
@@ -133,8 +57,14 @@ BusDigital::BusDigital(const BusConfig &bc)
 , _milliAmpsPerLed(bc.milliAmpsPerLed)
 , _milliAmpsMax(bc.milliAmpsMax)
 , _driverType(bc.driverType) // Store driver preference (0=RMT, 1=I2S)
+, _lut(nullptr)
+, _lutRGB(nullptr)
+, _lutGamma(-1.0f) // forces a rebuild of the input tables on first use
+, _lutBri(255)     // brightness table is not used at full brightness
+, _lutInput(false)
 {
   DEBUGBUS_PRINTLN(F("Bus: Creating digital bus."));
+  for (unsigned i = 0; i < WLED_BUS_LUT_KELVIN_SLOTS; i++) _lutOrder[i] = i;
   if (!isDigital(bc.type) || !bc.count) { DEBUGBUS_PRINTLN(F("Not digial or empty bus!")); return; }
   _iType = bc.iType; // reuse the iType that was determined by polyBus in getI() in finalizeInit()
   if (_iType == I_NONE) { DEBUGBUS_PRINTLN(F("Incorrect iType!")); return; }
@@ -142,6 +72,7 @@ BusDigital::BusDigital(const BusConfig &bc)
   if (!PinManager::allocatePin(bc.pins[0], true, PinOwner::BusDigital)) { DEBUGBUS_PRINTLN(F("Pin 0 allocated!")); return; }
   _frequencykHz = 0U;
   _colorSum = 0;
+  _ablBri = 255;
   _pins[0] = bc.pins[0];
   if (is2Pin(bc.type)) {
     if (!PinManager::allocatePin(bc.pins[1], true, PinOwner::BusDigital)) {
@@ -167,6 +98,7 @@ BusDigital::BusDigital(const BusConfig &bc)
   else {
     cleanup();
   }
+  if (_valid && WLED_BUS_LUT_MIN_LEN > 0 && bc.count >= WLED_BUS_LUT_MIN_LEN) _lut = static_cast<uint8_t*>(d_malloc(BUS_LUT_SIZE)); // optional, per-pixel math is used if it fails
   DEBUGBUS_PRINTF_P(PSTR("Bus len:%u, type:%u (RGB:%d, W:%d, CCT:%d), pins:%u,%u [itype:%u, driver:%s] mA=%d/%d %s\n"),
     (int)bc.count,
     (int)bc.type,
@@ -188,8 +120,10 @@ BusDigital::BusDigital(const BusConfig &bc)
 
 // note on ABL implementation:
 // ABL is set up in finalizeInit()
-// scaled color channels are summed in BusDigital::setPixelColor()
-// the used current is estimated and limited in BusManager::show()
+// predictive ABL (used by WS2812FX::show()): color channels of the composited frame are summed in BusDigital::predictCurrent()
+//   before output, the limit is calculated in BusManager::applyABL() and applied in the same pass that writes the pixels
+// otherwise scaled color channels are summed in BusDigital::setPixelColor() and the used current is estimated and
+//   limited in BusManager::show() by re-reading and repainting the bus buffer
 // if limit is set too low, brightness is limited to 1 to at least show some light
 // to disable brightness limiter for a bus, set LED current to 0
 
@@ -205,9 +139,36 @@ void BusDigital::estimateCurrent() {
   _milliAmpsTotal = ((uint64_t)_colorSum * actualMilliampsPerLed) / clrUnitsPerChannel + getLength(); // add 1mA standby current per LED to total (WS2812: ~0.7mA, WS2815: ~2mA)
 }
 
+// same channel sum as in setPixelColor() but taken from unscaled colors, bus brightness is applied to the sum
+void BusDigital::predictCurrent(unsigned start, const uint32_t *c, size_t len) {
+  if (!_valid || _milliAmpsPerLed == 0) return;
+  const bool kelvin = Bus::_cct >= 1900;
+  const bool ws2815 = _milliAmpsPerLed == 255;
+  if (_lut) updateLUT(_lutBri); // only the input tables are used here
+  uint32_t sum = 0;
+  for (size_t i = 0; i < len; i++) {
+    uint32_t col = c[i];
+    if (_lut) {
+      if (_lutInput) col = lutInput(col);
+    } else {
+      if (Bus::_gamma) col = gamma32(col);
+      if (kelvin) col = colorBalanceFromKelvin(Bus::_cct, col);
+    }
+    if (hasWhite()) {
+      uint8_t cctWW, cctCW; // unused
+      col = autoWhiteCalc(col, cctWW, cctCW);
+    }
+    uint8_t r = R(col), g = G(col), b = B(col);
+    if (!ws2815) sum += r + g + b + W(col);
+    else         sum += ((r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b));
+  }
+  _colorSum += (sum * _bri) / 255;
+}
+
 void BusDigital::applyBriLimit(uint8_t newBri) {
   // a newBri of 0 means calculate per-bus brightness limit
   _NPBbri = 255; // reset, intermediate value is set below, final value is calculated in bus::show()
+  _ablBri = 255;
   if (newBri == 0) {
     if (_milliAmpsLimit == 0 || _milliAmpsTotal == 0) return; // ABL not used for this bus
     newBri = 255;
@@ -224,7 +185,10 @@ void BusDigital::applyBriLimit(uint8_t newBri) {
     }
   }
 
-  if (newBri < 255) {
+  if (newBri < 255 && BusManager::_ablPredicted) {
+    _NPBbri = newBri;
+    _ablBri = newBri; // pixels are not written yet, limit is applied in setPixelColor()/setPixelColors()
+  } else if (newBri < 255) {
     _NPBbri = newBri; // store value so it can be updated in show() (must be updated even if ABL is not used)
     uint16_t wwcw = 0;
     unsigned hwLen = _len;
@@ -249,6 +213,7 @@ void BusDigital::applyBriLimit(uint8_t newBri) {
 void BusDigital::show() {
   if (!_valid) return;
   _NPBbri = (_NPBbri * _bri) / 255;      // total applied brightness for use in restoreColorLossy (see applyBriLimit())
+  _ablBri = 255;                         // predicted limit is valid for one frame only
   PolyBus::show(_busPtr, _iType, _skip); // faster if buffer consistency is not important (no skipped LEDs)
 }
 
@@ -273,15 +238,16 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   uint8_t cctWW = 0, cctCW = 0;
   uint16_t wwcw = 0;
   if (hasWhite()) c = autoWhiteCalc(c, cctWW, cctCW);
-  c = color_fade(c, _bri, true); // apply brightness
+  const uint8_t bri = _ablBri < 255 ? (_bri * _ablBri) / 255 : _bri; // include predicted ABL limit
+  c = color_fade(c, bri, true); // apply brightness
 
   if (hasCCT()) {
-    wwcw = ((cctCW + 1) * _bri) & 0xFF00; // apply brightness to CCT (store CW in upper byte)
-    wwcw |= ((cctWW + 1) * _bri) >> 8;
+    wwcw = ((cctCW + 1) * bri) & 0xFF00; // apply brightness to CCT (store CW in upper byte)
+    wwcw |= ((cctWW + 1) * bri) >> 8;
     if (_type == TYPE_WS2812_WWA) c = RGBW32(wwcw, wwcw >> 8, 0, W(c)); // ww,cw, 0, w
   }
 
-  if (BusManager::_useABL) {
+  if (BusManager::_useABL && !BusManager::_ablPredicted) {
     // if using ABL, sum all color channels to estimate current and limit brightness in show()
     uint8_t r = R(c), g = G(c), b = B(c);
     if (_milliAmpsPerLed < 255) { // normal ABL
@@ -308,6 +274,121 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   PolyBus::setPixelColor(_busPtr, _iType, pix, c, co, wwcw);
 }
 
+// rebuilds the output look-up tables if gamma, white balance or brightness changed since they were built
+// the tables give the same results as gamma32(), colorBalanceFromKelvin() and color_fade(c, bri, true) but replace
+// their per-channel math with one load each; they change rarely (ABL or brightness change, per-segment white balance)
+// R, G, B tables are kept for the most recently used Kelvin values, so segments with different CCT reuse them every frame
+void BusDigital::updateLUT(uint8_t bri) {
+  const float   gamma  = Bus::_gamma ? gammaCorrectVal : 0.0f;
+  const int16_t kelvin = Bus::_cct >= 1900 ? Bus::_cct : 0;
+  if (gamma != _lutGamma) {
+    for (unsigned v = 0; v < 256; v++) _lut[v] = Bus::_gamma ? gamma8(v) : v; // white is not color corrected
+    for (unsigned i = 0; i < WLED_BUS_LUT_KELVIN_SLOTS; i++) _lutKelvin[i] = -1;
+    _lutGamma = gamma;
+  }
+  // find the slot of this Kelvin value (or the least recently used one) and move it to the front
+  unsigned rank = 0;
+  while (rank < WLED_BUS_LUT_KELVIN_SLOTS-1 && _lutKelvin[_lutOrder[rank]] != kelvin) rank++;
+  const uint8_t slot = _lutOrder[rank];
+  for (; rank > 0; rank--) _lutOrder[rank] = _lutOrder[rank-1];
+  _lutOrder[0] = slot;
+  uint8_t *rgb = _lut + 512 + slot * 768;
+  if (_lutKelvin[slot] != kelvin) {
+    byte correctionRGB[4] = {255, 255, 255, 0};
+    if (kelvin) colorKtoRGB(kelvin, correctionRGB);
+    for (unsigned v = 0; v < 256; v++) {
+      const unsigned g = _lut[v];
+      rgb[v]       = (correctionRGB[0] * g) / 255;
+      rgb[256 + v] = (correctionRGB[1] * g) / 255;
+      rgb[512 + v] = (correctionRGB[2] * g) / 255;
+    }
+    _lutKelvin[slot] = kelvin;
+  }
+  _lutRGB   = rgb;
+  _lutInput = Bus::_gamma || kelvin;
+  if (bri != _lutBri) {
+    for (unsigned v = 0; v < 256; v++) _lut[256 + v] = (v * bri + 127) >> 8; // same rounding as color_fade() (video)
+    _lutBri = bri;
+  }
+}
+
+inline uint32_t BusDigital::lutInput(uint32_t c) const {
+  return RGBW32(_lutRGB[R(c)], _lutRGB[256 + G(c)], _lutRGB[512 + B(c)], _lut[W(c)]);
+}
+
+inline uint32_t BusDigital::lutFade(uint32_t c) const {
+  if (_lutBri == 255) return c;
+  if (_lutBri == 0)   return 0;
+  const uint8_t *t = _lut + 256;
+  const uint8_t r = R(c), g = G(c), b = B(c), w = W(c);
+  uint8_t maxc = (r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b);
+  maxc = (maxc>>2) + 1; // video scaling: channels above ~25% of the dominant channel do not fade to zero
+  return RGBW32(t[r] | (r > maxc), t[g] | (g > maxc), t[b] | (b > maxc), t[w] | (w > 0));
+}
+
+// same pipeline as setPixelColor() but with the stages that do not apply to this bus removed at compile time
+// note: WWA and 1CH_X3 types are not handled here (see setPixelColors())
+template<bool hasW, bool hasCCT, bool useABL, bool useCOMap>
+void BusDigital::setPixelSpan(unsigned start, const uint32_t *c, size_t len) {
+  const bool     kelvin   = Bus::_cct >= 1900;
+  const bool     gamma    = Bus::_gamma;
+  const bool     ws2815   = _milliAmpsPerLed == 255; // wacky WS2815 power model
+  const uint8_t  bri      = _ablBri < 255 ? (_bri * _ablBri) / 255 : _bri; // include predicted ABL limit
+  const bool     lut      = _lut != nullptr;
+  if (lut) updateLUT(bri);
+  const bool     useInput = lut && _lutInput;
+  uint32_t       colorSum = 0;
+  for (size_t i = 0; i < len; i++) {
+    uint32_t col = c[i];
+    if (useInput) col = lutInput(col); // gamma and color correction from CCT
+    else if (!lut) {
+      if (gamma)  col = gamma32(col);
+      if (kelvin) col = colorBalanceFromKelvin(Bus::_cct, col); //color correction from CCT
+    }
+    uint8_t cctWW = 0, cctCW = 0;
+    uint16_t wwcw = 0;
+    if (hasW) col = autoWhiteCalc(col, cctWW, cctCW);
+    col = lut ? lutFade(col) : color_fade(col, bri, true); // apply brightness
+    if (hasCCT) {
+      wwcw = ((cctCW + 1) * bri) & 0xFF00; // apply brightness to CCT (store CW in upper byte)
+      wwcw |= ((cctWW + 1) * bri) >> 8;
+    }
+    if (useABL) {
+      uint8_t r = R(col), g = G(col), b = B(col);
+      if (!ws2815) colorSum += r + g + b + W(col);
+      else         colorSum += ((r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b));
+    }
+    unsigned pix = start + i;
+    if (_reversed) pix = _len - pix -1;
+    pix += _skip;
+    const uint8_t co = useCOMap ? _colorOrderMap.getPixelColorOrder(pix+_start, _colorOrder) : _colorOrder;
+    PolyBus::setPixelColor(_busPtr, _iType, pix, col, co, wwcw);
+  }
+  if (useABL) _colorSum += colorSum;
+}
+
+void BusDigital::setPixelColors(unsigned start, const uint32_t *c, size_t len) {
+  if (!_valid) return;
+  if (_type == TYPE_WS2812_1CH_X3 || _type == TYPE_WS2812_WWA) {
+    for (size_t i = 0; i < len; i++) BusDigital::setPixelColor(start + i, Bus::_gamma ? gamma32(c[i]) : c[i]); // non-virtual call
+    return;
+  }
+  // digital buses with CCT always have a white channel, so there are 3 channel layouts x ABL x color order map
+  using SpanKernel = void (BusDigital::*)(unsigned, const uint32_t*, size_t);
+  static const SpanKernel kernels[12] = {
+    &BusDigital::setPixelSpan<false,false,false,false>, &BusDigital::setPixelSpan<false,false,false,true>,
+    &BusDigital::setPixelSpan<false,false,true, false>, &BusDigital::setPixelSpan<false,false,true, true>,
+    &BusDigital::setPixelSpan<true, false,false,false>, &BusDigital::setPixelSpan<true, false,false,true>,
+    &BusDigital::setPixelSpan<true, false,true, false>, &BusDigital::setPixelSpan<true, false,true, true>,
+    &BusDigital::setPixelSpan<true, true, false,false>, &BusDigital::setPixelSpan<true, true, false,true>,
+    &BusDigital::setPixelSpan<true, true, true, false>, &BusDigital::setPixelSpan<true, true, true, true>
+  };
+  const unsigned layout = hasCCT() ? 2 : hasWhite() ? 1 : 0;
+  const bool     abl    = BusManager::_useABL && !BusManager::_ablPredicted; // predicted ABL already has the sum
+  const unsigned k = layout * 4 + abl * 2 + (_colorOrderMap.count() > 0);
+  (this->*kernels[k])(start, c, len);
+}
+
 // returns lossly restored color from bus
 uint32_t IRAM_ATTR BusDigital::getPixelColor(unsigned pix) const {
   if (!_valid) return 0;
@@ -339,7 +420,7 @@ size_t BusDigital::getPins(uint8_t* pinArray) const {
 }
 
 size_t BusDigital::getBusSize() const {
-  return sizeof(BusDigital) + (isOk() ? PolyBus::getDataSize(_busPtr, _iType) : 0); // does not include common I2S DMA buffer
+  return sizeof(BusDigital) + (isOk() ? PolyBus::getDataSize(_busPtr, _iType) : 0) + (_lut ? BUS_LUT_SIZE : 0); // does not include common I2S DMA buffer
 }
 
 void BusDigital::setColorOrder(uint8_t colorOrder) {
@@ -388,6 +469,8 @@ void BusDigital::cleanup() {
   _iType = I_NONE;
   _valid = false;
   _busPtr = nullptr;
+  d_free(_lut);
+  _lut = nullptr;
   PinManager::deallocatePin(_pins[1], PinOwner::BusDigital);
   PinManager::deallocatePin(_pins[0], PinOwner::BusDigital);
 }
@@ -703,6 +786,7 @@ std::vector<LEDType> BusOnOff::getLEDTypes() {
 
 BusNetwork::BusNetwork(const BusConfig &bc)
 : Bus(bc.type, bc.start, bc.autoWhite, bc.count)
+, _startAddress(bc.frequency)
 , _broadcastLock(false)
 {
   switch (bc.type) {
@@ -733,16 +817,27 @@ BusNetwork::BusNetwork(const BusConfig &bc)
   DEBUGBUS_PRINTF_P(PSTR("%successfully inited virtual strip with type %u and IP %u.%u.%u.%u\n"), _valid?"S":"Uns", bc.type, bc.pins[0], bc.pins[1], bc.pins[2], bc.pins[3]);
 }
 
-void BusNetwork::setPixelColor(unsigned pix, uint32_t c) {
-  if (!_valid || pix >= _len) return;
+// white calculation, CCT color balance and channel packing shared by setPixelColor() and setPixelColors()
+inline void BusNetwork::packPixel(uint8_t *data, uint32_t c) {
   uint8_t ww, cw; // dummy, unused
   if (_hasWhite) c = autoWhiteCalc(c, ww, cw);
   if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
-  unsigned offset = pix * _UDPchannels;
-  _data[offset]   = R(c);
-  _data[offset+1] = G(c);
-  _data[offset+2] = B(c);
-  if (_hasWhite) _data[offset+3] = W(c);
+  data[0] = R(c);
+  data[1] = G(c);
+  data[2] = B(c);
+  if (_hasWhite) data[3] = W(c);
+}
+
+void BusNetwork::setPixelColor(unsigned pix, uint32_t c) {
+  if (!_valid || pix >= _len) return;
+  packPixel(_data + pix * _UDPchannels, c);
+}
+
+void BusNetwork::setPixelColors(unsigned start, const uint32_t *c, size_t len) {
+  if (!_valid || start >= _len) return;
+  if (start + len > _len) len = _len - start;
+  uint8_t *data = _data + start * _UDPchannels;
+  for (size_t i = 0; i < len; i++, data += _UDPchannels) packPixel(data, _gamma ? gamma32(c[i]) : c[i]);
 }
 
 uint32_t BusNetwork::getPixelColor(unsigned pix) const {
@@ -754,7 +849,7 @@ uint32_t BusNetwork::getPixelColor(unsigned pix) const {
 void BusNetwork::show() {
   if (!_valid || !canShow()) return;
   _broadcastLock = true;
-  realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, hasWhite());
+  realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, hasWhite(), _startAddress);
   _broadcastLock = false;
 }
 
@@ -791,6 +886,7 @@ std::vector<LEDType> BusNetwork::getLEDTypes() {
   return {
     {TYPE_NET_DDP_RGB,     "N",     PSTR("DDP RGB (network)")},      // should be "NNNN" to determine 4 "pin" fields
     {TYPE_NET_ARTNET_RGB,  "N",     PSTR("Art-Net RGB (network)")},
+    {TYPE_NET_E131_RGB,    "N",     PSTR("E1.31 RGB (network)")},
     {TYPE_NET_DDP_RGBW,    "N",     PSTR("DDP RGBW (network)")},
     {TYPE_NET_ARTNET_RGBW, "N",     PSTR("Art-Net RGBW (network)")},
     // hypothetical extensions
@@ -1271,6 +1367,7 @@ size_t BusConfig::memUsage() const {
   } else if (Bus::isDigital(type)) {
     // if any of digital buses uses I2S, there is additional common I2S DMA buffer not accounted for here
     mem += sizeof(BusDigital) + PolyBus::memUsage(count + skipAmount, iType);
+    if (WLED_BUS_LUT_MIN_LEN > 0 && count >= WLED_BUS_LUT_MIN_LEN) mem += BUS_LUT_SIZE;
   } else if (Bus::isOnOff(type)) {
     mem += sizeof(BusOnOff);
   } else {
@@ -1307,6 +1404,7 @@ int BusManager::add(const BusConfig &bc, bool placeholder) {
   } else {
     busses.push_back(make_unique<BusPwm>(bc));
   }
+  rebuildRoutes();
   return busses.size();
 }
 
@@ -1348,6 +1446,8 @@ void BusManager::removeAll() {
   //prevents crashes due to deleting busses while in use.
   while (!canAllShow()) yield();
   busses.clear();
+  _routes.clear();
+  _routesOverlap = false;
   #ifndef ESP8266
   // Reset channel tracking for fresh allocation
   PolyBus::resetChannelTracking();
@@ -1436,34 +1536,28 @@ void BusManager::off() {
 }
 
 void BusManager::show() {
-  applyABL(); // apply brightness limit, updates _gMilliAmpsUsed
+  if (!_ablPredicted) applyABL(); // apply brightness limit, updates _gMilliAmpsUsed
+  _ablPredicted = false;
   for (auto &bus : busses) {
     bus->show();
   }
 }
 
-void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
-  for (auto &bus : busses) {
-    if (!bus->containsPixel(pix)) continue;
-    bus->setPixelColor(pix - bus->getStart(), c);
-  }
+void BusManager::beginABLPrediction() {
+  if (!_useABL) return;
+  for (auto &bus : busses) if (bus->isDigital() && bus->isOk()) static_cast<BusDigital&>(*bus).resetColorSum();
+  _ablPredicted = true;
 }
 
-void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
-  if (cct > 255) cct = 255;
-  if (cct >= 0) {
-    //if white balance correction allowed, save as kelvin value instead of 0-255
-    if (allowWBCorrection) cct = 1900 + (cct << 5);
-  } else cct = -1; // will use kelvin approximation from RGB
-  Bus::setCCT(cct);
-}
-
-uint32_t BusManager::getPixelColor(unsigned pix) {
-  for (auto &bus : busses) {
-    if (!bus->containsPixel(pix)) continue;
-    return bus->getPixelColor(pix - bus->getStart());
+void BusManager::predictCurrent(unsigned start, const uint32_t *c, size_t len) {
+  const unsigned end = start + len;
+  for (const auto &r : _routes) {
+    if (r.start >= end) break; // routes are sorted by start
+    if (r.end <= start || !r.bus->isDigital()) continue;
+    const unsigned from = std::max(start, (unsigned)r.start);
+    const unsigned to   = std::min(end, (unsigned)r.end);
+    static_cast<BusDigital*>(r.bus)->predictCurrent(from - r.start, c + (from - start), to - from);
   }
-  return 0;
 }
 
 bool BusManager::canAllShow() {
@@ -1510,11 +1604,13 @@ void BusManager::initializeABL() {
 void BusManager::applyABL() {
   if (_useABL) {
     unsigned milliAmpsSum = 0; // use temporary variable to always return a valid _gMilliAmpsUsed to UI
+    unsigned milliAmpsPredicted = 0;
     unsigned totalLEDs = 0;
     for (auto &bus : busses) {
       if (bus->isDigital() && bus->isOk()) {
         BusDigital &busd = static_cast<BusDigital&>(*bus);
         busd.estimateCurrent(); // sets _milliAmpsTotal, current is estimated for all buses even if they have the limit set to 0
+        milliAmpsPredicted += busd.getUsedCurrent(); // before limiting
         if (_gMilliAmpsMax == 0)
           busd.applyBriLimit(0); // apply per bus ABL limit, updates _milliAmpsTotal if limit reached
         milliAmpsSum += busd.getUsedCurrent();
@@ -1545,9 +1641,10 @@ void BusManager::applyABL() {
       }
     }
     _gMilliAmpsUsed = milliAmpsSum;
+    _gMilliAmpsPredicted = std::min(milliAmpsPredicted, 65535U);
   }
   else
-    _gMilliAmpsUsed = 0; // reset, we have no current estimation without ABL
+    _gMilliAmpsUsed = _gMilliAmpsPredicted = 0; // reset, we have no current estimation without ABL
 }
 
 ColorOrderMap& BusManager::getColorOrderMap() { return _colorOrderMap; }
@@ -1562,13 +1659,5 @@ uint8_t PolyBus::_parallelBusItype = 0;    // type I_NONE
 uint8_t PolyBus::_2PchannelsAssigned = 0;
 #endif
 // Bus static member definition
-int16_t Bus::_cct = -1;     // -1 means use approximateKelvinFromRGB(), 0-255 is standard, >1900 use colorBalanceFromKelvin()
-int8_t  Bus::_cctBlend = 0; // -128 to +127
-uint8_t Bus::_gAWM = 255;
-
 uint16_t BusDigital::_milliAmpsTotal = 0;
 
-std::vector<std::unique_ptr<Bus>> BusManager::busses;
-uint16_t BusManager::_gMilliAmpsUsed = 0;
-uint16_t BusManager::_gMilliAmpsMax = ABL_MILLIAMPS_DEFAULT;
-bool BusManager::_useABL = false;
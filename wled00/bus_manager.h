@@ -70,6 +70,20 @@ uint16_t approximateKelvinFromRGB(uint32_t rgb);
 #define IC_INDEX_WS2812_2CH_3X(i)  ((i)*2/3)
 #define WS2812_2CH_3X_SPANS_2_ICS(i) ((i)&0x01)    // every other LED zone is on two different ICs
 
+// digital buses with at least this many LEDs use output look-up tables (see BusDigital::updateLUT()), 0 disables them
+#ifndef WLED_BUS_LUT_MIN_LEN
+  #define WLED_BUS_LUT_MIN_LEN 64
+#endif
+// number of white balance (Kelvin) values whose R, G, B input tables are kept, so per-segment CCT does not rebuild them per span
+#ifndef WLED_BUS_LUT_KELVIN_SLOTS
+  #ifdef ESP8266
+    #define WLED_BUS_LUT_KELVIN_SLOTS 2
+  #else
+    #define WLED_BUS_LUT_KELVIN_SLOTS 3
+  #endif
+#endif
+#define BUS_LUT_SIZE ((2 + 3*WLED_BUS_LUT_KELVIN_SLOTS)*256) // W input table + brightness table + R, G, B input tables per Kelvin slot
+
 struct BusConfig; // forward declaration
 
 // Defines an LED Strip and its color ordering.
@@ -132,6 +146,7 @@ class Bus {
     virtual bool     canShow() const                            { return true; }
     virtual void     setStatusPixel(uint32_t c)                 {}
     virtual void     setPixelColor(unsigned pix, uint32_t c)    = 0;
+    virtual void     setPixelColors(unsigned start, const uint32_t *c, size_t len); // bulk write of a contiguous run (bus relative), applies gamma if set
     virtual void     setBrightness(uint8_t b)                   { _bri = b; };
     virtual void     setColorOrder(uint8_t co)                  {}
     virtual uint32_t getPixelColor(unsigned pix) const          { return 0; }
@@ -203,6 +218,8 @@ class Bus {
     static inline void     setGlobalAWMode(uint8_t m) { if (m < 5) _gAWM = m; else _gAWM = AW_GLOBAL_DISABLED; }
     static inline uint8_t  getGlobalAWMode()          { return _gAWM; }
     static inline void     setCCT(int16_t cct)        { _cct = cct; }
+    static inline void     setGammaCorrection(bool g) { _gamma = g; }
+    static inline bool     getGammaCorrection()       { return _gamma; }
     static inline int8_t   getCCTBlend()              { return (_cctBlend * 100 + (_cctBlend >= 0 ? 64 : -64)) / 127; } // returns -100 to +100, +/-100% = +/-127. +/-64 for rounding 
     static inline void     setCCTBlend(int8_t b) {    // input is -100 to +100
       _cctBlend = (std::max(-100, std::min(100, (int)b)) * 127 + (b >= 0 ? 50 : -50)) / 100; // +/-50 for rounding, b=+/-100% -> +/-127
@@ -240,6 +257,8 @@ class Bus {
     //   63 - semi additive/nonlinear (CCT 127 => 66% warm, 66% cold)
     //  127 - additive CCT blending (CCT 127 => 100% warm, 100% cold)
     static int8_t _cctBlend;
+    // _gamma is set by WS2812FX::show() while the frame is written: colors passed to setPixelColors() are not gamma corrected yet
+    static bool _gamma;
 
     uint32_t autoWhiteCalc(uint32_t c, uint8_t &ww, uint8_t &cw) const;
 };
@@ -254,6 +273,7 @@ class BusDigital : public Bus {
     bool canShow() const override;
     void setStatusPixel(uint32_t c) override;
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixelColors(unsigned start, const uint32_t *c, size_t len) override;
     void setColorOrder(uint8_t colorOrder) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     uint8_t  getColorOrder() const override  { return _colorOrder; }
@@ -266,6 +286,8 @@ class BusDigital : public Bus {
     uint8_t  getDriverType() const override  { return _driverType; }
     void     setCurrentLimit(uint16_t milliAmps) { _milliAmpsLimit = milliAmps; }
     void     estimateCurrent(); // estimate used current from summed colors
+    void     predictCurrent(unsigned start, const uint32_t *c, size_t len); // sum colors of a span before it is written (predictive ABL)
+    inline void resetColorSum() { _colorSum = 0; }
     void     applyBriLimit(uint8_t newBri);
     size_t   getBusSize() const override;
     bool isI2S(); // true if this bus uses I2S driver
@@ -284,8 +306,27 @@ class BusDigital : public Bus {
     uint16_t _milliAmpsMax;
     uint8_t  _milliAmpsPerLed;
     uint16_t _milliAmpsLimit;
+    uint8_t  _ablBri;   // brightness limit applied while writing pixels if ABL was predicted (255 = no limit)
     uint32_t _colorSum; // total color value for the bus, updated in setPixelColor(), used to estimate current
     void    *_busPtr;
+    // output look-up tables: W input table (gamma), brightness table, then R, G, B input tables (gamma and Kelvin correction)
+    // for each of the WLED_BUS_LUT_KELVIN_SLOTS most recently used white balance values
+    // rebuilt only when one of the inputs below changes, nullptr for short buses (see WLED_BUS_LUT_MIN_LEN)
+    uint8_t *_lut;
+    const uint8_t *_lutRGB; // R, G, B input tables of the current white balance
+    float    _lutGamma;  // gamma of the input tables (0 = no gamma correction)
+    int16_t  _lutKelvin[WLED_BUS_LUT_KELVIN_SLOTS]; // white balance of the R, G, B tables in each slot (0 = no correction, -1 = unused)
+    uint8_t  _lutOrder[WLED_BUS_LUT_KELVIN_SLOTS];  // slots, most recently used first
+    uint8_t  _lutBri;    // brightness of the brightness table
+    bool     _lutInput;  // input tables are not identity
+
+    void updateLUT(uint8_t bri);
+    inline uint32_t lutInput(uint32_t c) const; // gamma32() and colorBalanceFromKelvin() using the input tables
+    inline uint32_t lutFade(uint32_t c) const;  // color_fade(c, _lutBri, true) using the brightness table
+
+    // specialized span kernel (see setPixelColors()), pipeline stages are selected at compile time
+    template<bool hasW, bool hasCCT, bool useABL, bool useCOMap>
+    void setPixelSpan(unsigned start, const uint32_t *c, size_t len);
 
     static uint16_t _milliAmpsTotal; // is overwitten/recalculated on each show()
 
@@ -357,9 +398,11 @@ class BusNetwork : public Bus {
 
     bool canShow() const override  { return !_broadcastLock; } // this should be a return value from UDP routine if it is still sending data out
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixelColors(unsigned start, const uint32_t *c, size_t len) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     size_t getPins(uint8_t* pinArray = nullptr) const override;
     size_t getBusSize() const override  { return sizeof(BusNetwork) + (isOk() ? _len * _UDPchannels : 0); }
+    uint16_t getFrequency() const override { return _startAddress; } // stored in the frequency field of the configuration
     void   show() override;
     void   cleanup();
     #ifdef ARDUINO_ARCH_ESP32
@@ -373,11 +416,14 @@ class BusNetwork : public Bus {
     IPAddress _client;
     uint8_t   _UDPtype;
     uint8_t   _UDPchannels;
+    uint16_t  _startAddress; // first universe (E1.31, Art-Net) or data offset (DDP)
     bool      _broadcastLock;
     uint8_t   *_data;
     #ifdef ARDUINO_ARCH_ESP32
     String    _hostname;
     #endif
+
+    inline void packPixel(uint8_t *data, uint32_t c);
 };
 
 // Placeholder for buses that we can't construct due to resource limitations
@@ -389,6 +435,7 @@ class BusPlaceholder : public Bus {
 
     // Actual calls are stubbed out
     void setPixelColor(unsigned pix, uint32_t c) override {};
+    void setPixelColors(unsigned start, const uint32_t *c, size_t len) override {};
     void show() override {};
 
     // Accessors
@@ -526,13 +573,24 @@ struct BusConfig {
   #endif
 #endif
 
+// contiguous range of physical pixels [start, end) driven by a single bus, see BusManager::rebuildRoutes()
+struct BusRoute {
+  uint16_t start;
+  uint16_t end;
+  Bus     *bus;
+};
+
 namespace BusManager {
 
   extern std::vector<std::unique_ptr<Bus>> busses;
   //extern std::vector<Bus*> busses;
+  extern std::vector<BusRoute> _routes; // pixel to bus routing table, sorted by start, rebuilt in add()/removeAll()
+  extern bool     _routesOverlap;       // true if any pixel is driven by more than one bus
   extern uint16_t _gMilliAmpsUsed;
+  extern uint16_t _gMilliAmpsPredicted; // current the frame would draw without limiting
   extern uint16_t _gMilliAmpsMax;
   extern bool     _useABL;
+  extern bool     _ablPredicted;        // ABL for the current frame was calculated before output (limit is applied while writing pixels)
 
   #ifdef ESP32_DATA_IDLE_HIGH
   void    esp32RMTInvertIdle() ;
@@ -544,11 +602,15 @@ namespace BusManager {
   }
 
   inline uint16_t currentMilliamps()            { return _gMilliAmpsUsed + MA_FOR_ESP; }
+  inline uint16_t predictedMilliamps()          { return _gMilliAmpsPredicted + MA_FOR_ESP; }
   //inline uint16_t ablMilliampsMax()             { unsigned sum = 0; for (auto &bus : busses) sum += bus->getMaxCurrent(); return sum; }
   inline uint16_t ablMilliampsMax()             { return _gMilliAmpsMax; }  // used for compatibility reasons (and enabling virtual global ABL)
   inline void     setMilliampsMax(uint16_t max) { _gMilliAmpsMax = max;}
   void            initializeABL();              // setup automatic brightness limiter parameters, call once after buses are initialized
   void            applyABL();                   // apply automatic brightness limiter, global or per bus
+  // predictive ABL: beginABLPrediction(), predictCurrent() for all pixels, applyABL(), then set pixels (see WS2812FX::show())
+  void            beginABLPrediction();
+  [[gnu::hot]] void predictCurrent(unsigned start, const uint32_t *c, size_t len);
 
   uint8_t getI(uint8_t busType, const uint8_t* pins, uint8_t driverPreference); // workaround for access to PolyBus function from FX_fcn.cpp
 
@@ -559,7 +621,10 @@ namespace BusManager {
   void on();
   void off();
 
+  void rebuildRoutes();
+
   [[gnu::hot]] void     setPixelColor(unsigned pix, uint32_t c);
+  [[gnu::hot]] void     setPixelColors(unsigned start, const uint32_t *c, size_t len); // write a run of consecutive physical pixels
   [[gnu::hot]] uint32_t getPixelColor(unsigned pix);
   void        show();
   bool        canAllShow();
@@ -379,6 +379,7 @@ void handleOnOff(bool forceOff)
   if (strip.getBrightness() && !forceOff) {
     lastOnTime = millis();
     if (offMode) {
+      strip.waitForOutput(); // output task may be sending to the buses
       BusManager::on();
       if (rlyPin>=0) {
         // note: pinMode is set in first call to handleOnOff(true) in beginStrip()
@@ -390,6 +391,7 @@ void handleOnOff(bool forceOff)
   } else if ((millis() - lastOnTime > 600 && !strip.needsUpdate()) || forceOff) {
     // for turning LED or relay off we need to wait until strip no longer needs updates (strip.trigger())
     if (!offMode) {
+      strip.waitForOutput();
       BusManager::off();
       if (rlyPin>=0) {
         digitalWrite(rlyPin, !rlyMde); // set output before disabling high-z state to avoid output glitches
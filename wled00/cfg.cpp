@@ -263,6 +263,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
     }
   } else if (fromFS) {
     //if busses failed to load, add default (fresh install, FS issue, ...)
+    strip.waitForOutput(); // buses are in use by output task
     BusManager::removeAll();
     busConfigs.clear();
 
@@ -606,6 +607,8 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   JsonObject if_live_dmx = if_live["dmx"];
   CJSON(e131Universe, if_live_dmx[F("uni")]);
   CJSON(e131SkipOutOfSequence, if_live_dmx[F("seqskip")]);
+  CJSON(e131FrameTimeout, if_live_dmx[F("ftimeout")]);
+  if (e131FrameTimeout > 1000) e131FrameTimeout = 1000;
   CJSON(DMXAddress, if_live_dmx[F("addr")]);
   if (!DMXAddress || DMXAddress > 510) DMXAddress = 1;
   CJSON(DMXSegmentSpacing, if_live_dmx[F("dss")]);
@@ -1149,6 +1152,7 @@ void serializeConfig(JsonObject root) {
   JsonObject if_live_dmx = if_live.createNestedObject("dmx");
   if_live_dmx[F("uni")] = e131Universe;
   if_live_dmx[F("seqskip")] = e131SkipOutOfSequence;
+  if_live_dmx[F("ftimeout")] = e131FrameTimeout;
   if_live_dmx[F("e131prio")] = e131Priority;
   if_live_dmx[F("addr")] = DMXAddress;
   if_live_dmx[F("dss")] = DMXSegmentSpacing;
@@ -384,7 +384,7 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 //Network types (master broadcast) (80-95)
 #define TYPE_VIRTUAL_MIN         80
 #define TYPE_NET_DDP_RGB         80            //network DDP RGB bus (master broadcast bus)
-#define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus, unused)
+#define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus)
 #define TYPE_NET_ARTNET_RGB      82            //network ArtNet RGB bus (master broadcast bus, unused)
 #define TYPE_NET_DDP_RGBW        88            //network DDP RGBW bus (master broadcast bus)
 #define TYPE_NET_ARTNET_RGBW     89            //network ArtNet RGB bus (master broadcast bus, unused)
@@ -531,6 +531,8 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 #define JSON_LOCK_LEDMAP_ENUM     21
 #define JSON_LOCK_REMOTE          22
 #define JSON_LOCK_OTA             23
+#define JSON_LOCK_PRESET_COMPACT  24
+#define JSON_LOCK_PRESET_INVALID  25
 
 // Timer mode types
 #define NL_MODE_SET               0            //After nightlight time elapsed, set to target brightness
@@ -662,6 +664,16 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
   #endif
 #endif
 
+// number of additional JSON documents (of JSON_BUFFER_SIZE) used to serialize API responses (util.cpp), allocated in PSRAM
+// on first use and kept; without PSRAM there is no pool (allocating a document per request would fragment the heap)
+#ifndef JSON_POOL_SIZE
+  #if defined(BOARD_HAS_PSRAM)
+    #define JSON_POOL_SIZE 3
+  #else
+    #define JSON_POOL_SIZE 0
+  #endif
+#endif
+
 // minimum heap size required to process web requests: try to keep free heap above this value
 #ifdef ESP8266
   #define MIN_HEAP_SIZE (9*1024)
@@ -678,6 +690,18 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
   #define PSRAM_THRESHOLD (2*1024) // S2 does not have a lot of RAM. C3 and ESP8266 do not support PSRAM: the value is not used
 #endif
 
+// RAM used to cache presets pre-parsed into MessagePack (presets.cpp), 0 disables the cache
+#ifndef PRESET_CACHE_SIZE
+  #ifdef ESP8266
+    #define PRESET_CACHE_SIZE (2*1024)
+  #else
+    #define PRESET_CACHE_SIZE (8*1024)
+  #endif
+#endif
+#ifndef PRESET_CACHE_PSRAM_SIZE
+  #define PRESET_CACHE_PSRAM_SIZE (64*1024) // used instead of PRESET_CACHE_SIZE if PSRAM is found
+#endif
+
 // Web server limits
 #ifdef ESP8266
 // Minimum heap to consider handling a request
@@ -722,6 +746,7 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 #define DEFAULT_LED_COUNT 30
 
 #define INTERFACE_UPDATE_COOLDOWN 1000 // time in ms to wait between websockets, alexa, and MQTT updates
+#define WS_DELTA_FULL_INTERVAL  60000 // time in ms between full state pushes to websocket clients that subscribed to deltas
 
 #define PIN_RETRY_COOLDOWN   3000 // time in ms after an incorrect attempt PIN and OTA pass will be rejected even if correct
 #define PIN_TIMEOUT        900000 // time in ms after which the PIN will be required again, 15 minutes
@@ -26,7 +26,7 @@ var pmt = 1, pmtLS = 0;
 var lastinfo = {};
 var isM = false, mw = 0, mh=0;
 var bsOpts = null; // blending style options snapshot, used for dynamic filtering based on matrix mode (iOS compatibility)
-var ws, wsRpt=0;
+var ws, wsRpt=0, wsFull=null; // wsFull: last full state/info pushed over WS, deltas are merged into it
 var _selFxInterval = null; // interval ID for selected effect position update
 var cfg = {
 	theme:{base:"dark", bg:{url:"", rnd: false, rndGrayscale: false, rndBlur: false}, alpha:{bg:0.6,tab:0.8}, color:{bg:""}},
@@ -700,10 +700,12 @@ function parseInfo(i) {
 function populateInfo(i)
 {
 	var cn="";
-	var pwr = i.leds.pwr;
-	var pwru = "Not calculated";
-	if (pwr > 1000) {pwr /= 1000; pwr = pwr.toFixed((pwr > 10) ? 0 : 1); pwru = pwr + " A";}
-	else if (pwr > 0) {pwr = 50 * Math.round(pwr/50); pwru = pwr + " mA";}
+	let fmtPwr = (pwr) => {
+		if (pwr > 1000) {pwr /= 1000; return pwr.toFixed((pwr > 10) ? 0 : 1) + " A";}
+		if (pwr > 0) return 50 * Math.round(pwr/50) + " mA";
+		return "Not calculated";
+	};
+	var pwru = fmtPwr(i.leds.pwr);
 	var urows="";
 	if (i.u) {
 		for (const [k, val] of Object.entries(i.u)) {
@@ -730,6 +732,7 @@ ${i.psram?inforow("Free PSRAM",(i.psram/1024).toFixed(1)," kB"):""}
 <tr><td colspan=2><hr class="sml"></td></tr>
 ${i.leds.count?inforow("Total LEDs",i.leds.count):""}
 ${inforow("Estimated current",pwru)}
+${i.leds.ppwr>i.leds.pwr?inforow("Current before limit",fmtPwr(i.leds.ppwr)):""}
 ${inforow("Average FPS",i.leds.fps)}
 <tr><td colspan=2><hr class="sml"></td></tr>
 ${inforow("MAC address",i.mac)}
@@ -1435,6 +1438,13 @@ function makeWS() {
 		if (e.data instanceof ArrayBuffer) return; // liveview packet
 		var json = JSON.parse(e.data);
 		if (json.leds) return; // JSON liveview packet
+		if (json.delta !== undefined) { // only changes since the last broadcast (see ws.cpp)
+			if (!wsFull || json.delta != wsFull.dv+1) { ws.send('{"delta":true}'); return; } // missed a message, request full state
+			mergeWS(wsFull.state, json.state, true);
+			mergeWS(wsFull.info, json.info);
+			wsFull.dv = json.delta;
+			json = wsFull;
+		} else if (json.dv !== undefined) wsFull = json; // unversioned replies to this client only must not become the base, deltas are against the last broadcast
 		clearTimeout(jsonTimeout);
 		jsonTimeout = null;
 		lastUpdate = new Date();
@@ -1453,16 +1463,32 @@ function makeWS() {
 	};
 	ws.onclose = (e)=>{
 		gId('connind').style.backgroundColor = "var(--c-r)";
+		wsFull = null;
 		if (wsRpt++ < 10) setTimeout(makeWS,wsRpt * 200); // retry WS connection
 		ws = null;
 	}
 	ws.onopen = (e)=>{
 		//ws.send("{'v':true}"); // unnecessary (https://github.com/wled/WLED/blob/master/wled00/ws.cpp#L18)
+		ws.send('{"delta":true}'); // subscribe to state changes only
 		wsRpt = 0;
 		reqsLegal = true;
 	}
 }
 
+// apply WS delta d to the last full state/info o, null removes a key
+function mergeWS(o, d, isState=false)
+{
+	if (!d) return;
+	for (let k in d) {
+		if (isState && (k === "seg" || k === "rmseg")) continue;
+		if (d[k] === null) delete o[k];
+		else o[k] = d[k];
+	}
+	if (!isState || !(d.seg || d.rmseg)) return;
+	let rm = (d.rmseg || []).concat((d.seg || []).map((s)=>s.id));
+	o.seg = o.seg.filter((s)=>!rm.includes(s.id)).concat(d.seg || []).sort((a,b)=>a.id-b.id);
+}
+
 function readState(s,command=false)
 {
 	if (!s) return false;
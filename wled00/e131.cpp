@@ -9,6 +9,41 @@ static void handleDDPPacket(e131_packet_t* p, size_t packetLen);
 static void handleArtnetPollReply(IPAddress ipAddress);
 static void prepareArtnetPollReply(ArtPollReply *reply);
 static void sendArtnetPollReply(ArtPollReply *reply, IPAddress ipAddress, uint16_t portAddress);
+static unsigned getUniverseCount();
+
+// frame assembly: the universes of a frame are collected and shown together once all of them have been received,
+// on a universe sync packet (E1.31 synchronization, ArtSync) or when e131FrameTimeout ms have passed
+static uint32_t      frameUniverses = 0;     // universes received for the pending frame (bit n = e131Universe + n)
+static unsigned long frameStart = 0;         // arrival of the first universe of the pending frame
+static uint16_t      frameSyncUniverse = 0;  // E1.31 synchronization universe of the pending frame (0 = none)
+static uint8_t       frameMode = REALTIME_MODE_E131;
+static unsigned long lastArtSync = 0;        // Art-Net output is synchronous while ArtSync is received (4s, Art-Net 4)
+static bool          frameAssembly = false;  // handleDMXData() is called for a frame being assembled
+
+static inline uint32_t frameComplete() { return (1UL << getUniverseCount()) - 1; }
+
+static void commitFrame() {
+  if (frameUniverses != frameComplete()) e131FramesPartial++;
+  frameUniverses = 0;
+  e131NewData = true;
+}
+
+static bool waitingForSync() {
+  if (frameMode == REALTIME_MODE_ARTNET) return lastArtSync && millis() - lastArtSync < 4000;
+  return frameSyncUniverse != 0;
+}
+
+static void handleSyncPacket(uint16_t syncUniverse, uint8_t mde) {
+  if (mde == REALTIME_MODE_ARTNET) lastArtSync = millis();
+  if (!frameUniverses || frameMode != mde) return;
+  if (mde == REALTIME_MODE_E131 && syncUniverse != frameSyncUniverse) return;
+  commitFrame();
+}
+
+// shows a frame that is still missing universes or its sync packet after e131FrameTimeout, called from handleNotifications()
+void handleE131FrameTimeout() {
+  if (frameUniverses && millis() - frameStart > e131FrameTimeout) commitFrame();
+}
 
 
 /*
@@ -78,11 +113,7 @@ static void handleDDPPacket(e131_packet_t* p, size_t packetLen) {
   if (realtimeMode != REALTIME_MODE_DDP) ddpSeenPush = false; // just starting, no push yet
   realtimeLock(realtimeTimeoutMs, REALTIME_MODE_DDP);
 
-  if (!realtimeOverride) {
-    for (unsigned i = start; i < stop; i++, c += ddpChannelsPerLed) {
-      setRealtimePixel(i, data[c], data[c+1], data[c+2], ddpChannelsPerLed >3 ? data[c+3] : 0);
-    }
-  }
+  if (!realtimeOverride) setRealtimePixels(start, data + c, numLeds, ddpChannelsPerLed);
 
   ddpSeenPush |= push;
   if (!ddpSeenPush || push) { // if we've never seen a push, or this is one, render display
@@ -106,6 +137,10 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol, size_
       handleArtnetPollReply(clientIP);
       return;
     }
+    if (p->art_opcode == ARTNET_OPCODE_OPSYNC) {
+      handleSyncPacket(0, REALTIME_MODE_ARTNET);
+      return;
+    }
     if (packetLen < 18) return; // need art_length (offset 16, 2 bytes) for DMX data
     uni = p->art_universe;
     dmxChannels = htons(p->art_length);
@@ -116,6 +151,10 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol, size_
     seq = p->art_sequence_number;
     mde = REALTIME_MODE_ARTNET;
   } else if (protocol == P_E131) {
+    if (packetLen >= E131_SYNC_PACKET_LEN && htonl(p->root_vector) == E131_VECTOR_ROOT_EXTENDED) {
+      if (htonl(p->sync_vector) == E131_VECTOR_EXTENDED_SYNC) handleSyncPacket(htons(p->sync_universe), REALTIME_MODE_E131);
+      return;
+    }
     if (packetLen < 126) return; // need up to property_values[0] (offset 125) and property_value_count (offset 123)
     // Ignore PREVIEW data (E1.31: 6.2.6)
     if ((p->options & 0x80) != 0) return;
@@ -156,17 +195,44 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol, size_
 
   unsigned previousUniverses = uni - e131Universe;
 
-  if (e131SkipOutOfSequence)
-    if (seq < e131LastSequenceNumber[previousUniverses] && seq > 20 && e131LastSequenceNumber[previousUniverses] < 250){
+  // packet is a duplicate or belongs to an older frame than the last one received for this universe (E1.31: 6.7.2),
+  // or is further behind without having wrapped around (previous check), Art-Net sequence 0 = disabled
+  const unsigned lastSeq = e131LastSequenceNumber[previousUniverses];
+  const int seqDiff = int8_t(seq - lastSeq);
+  const bool seqEnabled = seq != 0 || mde != REALTIME_MODE_ARTNET;
+  if (seqEnabled && ((seqDiff <= 0 && seqDiff > -20) || (seq < lastSeq && seq > 20 && lastSeq < 250))) {
+    e131PacketsLate++;
+    if (e131SkipOutOfSequence) {
       DEBUG_PRINTF_P(PSTR("skipping E1.31 frame (last seq=%d, current seq=%d, universe=%d)\n"), e131LastSequenceNumber[previousUniverses], seq, uni);
       return;
     }
+  }
   e131LastSequenceNumber[previousUniverses] = seq;
 
   // update status info
   realtimeIP = clientIP;
 
-  handleDMXData(uni, dmxChannels, e131_data, mde, previousUniverses);
+  // only modes that set LED colors (single or multiple RGB) are assembled, effect and preset modes act immediately
+  frameAssembly = e131FrameTimeout && !realtimeOverride && previousUniverses < getUniverseCount() &&
+                  (DMXMode == DMX_MODE_SINGLE_RGB || DMXMode == DMX_MODE_SINGLE_DRGB || (DMXMode >= DMX_MODE_MULTIPLE_RGB && DMXMode <= DMX_MODE_MULTIPLE_RGBW));
+  if (frameAssembly) {
+    const uint32_t bit = 1UL << previousUniverses;
+    if (frameUniverses & bit) { // next frame has started before the pending one could be shown
+      e131FramesDropped++;
+      frameUniverses = 0;
+    }
+    if (!frameUniverses) {
+      frameStart = millis();
+      frameSyncUniverse = (protocol == P_E131) ? htons(p->sync_address) : 0;
+      frameMode = mde;
+    }
+    handleDMXData(uni, dmxChannels, e131_data, mde, previousUniverses);
+    frameUniverses |= bit; // after the pixels have been written, so the frame is not shown early
+    if (frameUniverses == frameComplete() && !waitingForSync()) commitFrame();
+    frameAssembly = false;
+  } else {
+    handleDMXData(uni, dmxChannels, e131_data, mde, previousUniverses);
+  }
 }
 
 void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8_t mde, uint8_t previousUniverses) {
@@ -363,10 +429,7 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
           }
         }
 
-        for (unsigned i = previousLeds; i < ledsTotal; i++) {
-          setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], is4Chan ? e131_data[dmxOffset+3] : 0);
-          dmxOffset += dmxChannelsPerLed;
-        }
+        if (ledsTotal > previousLeds) setRealtimePixels(previousLeds, e131_data + dmxOffset, ledsTotal - previousLeds, dmxChannelsPerLed);
         break;
       }
     default:
@@ -375,7 +438,7 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
       break;
   }
 
-  e131NewData = true;
+  if (!frameAssembly) e131NewData = true; // otherwise shown once the frame is complete
 }
 
 static void handleArtnetPollReply(IPAddress ipAddress) {
@@ -401,30 +464,8 @@ static void handleArtnetPollReply(IPAddress ipAddress) {
     case DMX_MODE_MULTIPLE_DRGB:
     case DMX_MODE_MULTIPLE_RGB:
     case DMX_MODE_MULTIPLE_RGBW:
-      {
-        bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
-        const unsigned dmxChannelsPerLed = is4Chan ? 4 : 3;
-        const unsigned dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
-        const unsigned dmxLenOffset = (DMXAddress == 0) ? 0 : 1; // For legacy DMX start address 0
-        const unsigned ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
-        const unsigned totalLen = strip.getLengthTotal();
-
-        if (totalLen > ledsInFirstUniverse) {
-          const unsigned ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
-          const unsigned remainLED = totalLen - ledsInFirstUniverse;
-
-          endUniverse += (remainLED / ledsPerUniverse);
-
-          if ((remainLED % ledsPerUniverse) > 0) {
-            endUniverse++;
-          }
-
-          if ((endUniverse - startUniverse) > E131_MAX_UNIVERSE_COUNT) {
-            endUniverse = startUniverse + E131_MAX_UNIVERSE_COUNT - 1;
-          }
-        }
-        break;
-      }
+      endUniverse += getUniverseCount() - 1;
+      break;
     default:
       DEBUG_PRINTLN(F("unknown E1.31 DMX mode"));
       return;  // nothing to do
@@ -444,6 +485,35 @@ static void handleArtnetPollReply(IPAddress ipAddress) {
   #endif
 }
 
+// number of consecutive universes (starting at e131Universe) used by the DMX mode
+static unsigned getUniverseCount() {
+  if (DMXMode != DMX_MODE_MULTIPLE_DRGB && DMXMode != DMX_MODE_MULTIPLE_RGB && DMXMode != DMX_MODE_MULTIPLE_RGBW) return 1;
+
+  const bool is4Chan = (DMXMode == DMX_MODE_MULTIPLE_RGBW);
+  const unsigned dmxChannelsPerLed = is4Chan ? 4 : 3;
+  const unsigned dimmerOffset = (DMXMode == DMX_MODE_MULTIPLE_DRGB) ? 1 : 0;
+  const unsigned dmxLenOffset = (DMXAddress == 0) ? 0 : 1; // For legacy DMX start address 0
+  const unsigned ledsInFirstUniverse = (((MAX_CHANNELS_PER_UNIVERSE - DMXAddress) + dmxLenOffset) - dimmerOffset) / dmxChannelsPerLed;
+  const unsigned totalLen = strip.getLengthTotal();
+  unsigned count = 1;
+
+  if (totalLen > ledsInFirstUniverse) {
+    const unsigned ledsPerUniverse = is4Chan ? MAX_4_CH_LEDS_PER_UNIVERSE : MAX_3_CH_LEDS_PER_UNIVERSE;
+    const unsigned remainLED = totalLen - ledsInFirstUniverse;
+
+    count += (remainLED / ledsPerUniverse);
+
+    if ((remainLED % ledsPerUniverse) > 0) {
+      count++;
+    }
+
+    if (count > E131_MAX_UNIVERSE_COUNT) {
+      count = E131_MAX_UNIVERSE_COUNT;
+    }
+  }
+  return count;
+}
+
 static void prepareArtnetPollReply(ArtPollReply *reply) {
   // Art-Net
   reply->reply_id[0] = 0x41;
@@ -111,6 +111,7 @@ void handleDMXInput();
 //e131.cpp
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol, size_t packetLen);
 void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8_t mde, uint8_t previousUniverses);
+void handleE131FrameTimeout();
 // void handleArtnetPollReply(IPAddress ipAddress);                                          // local function, only used in e131.cpp
 // void prepareArtnetPollReply(ArtPollReply* reply);                                         // local function, only used in e131.cpp
 // void sendArtnetPollReply(ArtPollReply* reply, IPAddress ipAddress, uint16_t portAddress); // local function, only used in e131.cpp
@@ -123,6 +124,12 @@ bool readObjectFromFileUsingId(const char* file, uint16_t id, JsonDocument* dest
 bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, const JsonDocument* filter = nullptr);
 void updateFSInfo();
 void closeFile();
+void invalidatePresetIndex();
+void compactPresetsFile();
+void recoverPresetsFile();
+#ifdef WLED_DEBUG
+void printPresetIndexStats();
+#endif
 inline bool writeObjectToFileUsingId(const String &file, uint16_t id, const JsonDocument* content) { return writeObjectToFileUsingId(file.c_str(), id, content); };
 inline bool writeObjectToFile(const String &file, const char* key, const JsonDocument* content) { return writeObjectToFile(file.c_str(), key, content); };
 inline bool readObjectFromFileUsingId(const String &file, uint16_t id, JsonDocument* dest, const JsonDocument* filter = nullptr) { return readObjectFromFileUsingId(file.c_str(), id, dest); };
@@ -299,11 +306,12 @@ uint16_t getRolloverMillis();
 
 //udp.cpp
 void notify(byte callMode, bool followUp=false);
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri=255, bool isRGBW=false);
+uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri=255, bool isRGBW=false, uint16_t start=0);
 void realtimeLock(uint32_t timeoutMs, byte md = REALTIME_MODE_GENERIC);
 void exitRealtime();
 void handleNotifications();
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
+void setRealtimePixels(unsigned start, const uint8_t *data, size_t count, unsigned channels);
 void refreshNodeList();
 void sendSysInfoUDP();
 #ifndef WLED_DISABLE_ESPNOW
@@ -458,6 +466,10 @@ uint32_t utf8_decode(const char *s, uint8_t *len);
 size_t utf8_strlen(const char *s);
 bool requestJSONBufferLock(uint8_t moduleID=JSON_LOCK_UNKNOWN);
 void releaseJSONBufferLock();
+JsonDocument *requestJSONBuffer(uint8_t moduleID=JSON_LOCK_UNKNOWN);
+void releaseJSONBufferState(JsonDocument *doc);
+void releaseJSONBuffer(JsonDocument *doc);
+void serializeJSONBufferStats(JsonObject root);
 uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLen);
 uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxLen, uint8_t *var = nullptr);
 int16_t extractModeDefaults(uint8_t mode, const char *segVar);
@@ -490,6 +502,12 @@ uint16_t perlin16(uint32_t x, uint32_t y, uint32_t z);
 uint8_t perlin8(uint16_t x);
 uint8_t perlin8(uint16_t x, uint16_t y);
 uint8_t perlin8(uint16_t x, uint16_t y, uint16_t z);
+// batch noise: out[i] = perlin16()/perlin8() at (x + i*stepX, y + i*stepY[, z + i*stepZ]), much faster than calling them per pixel
+void perlin16Line(uint16_t *out, unsigned count, uint32_t x, uint32_t y, int32_t stepX, int32_t stepY);
+void perlin16Line(uint16_t *out, unsigned count, uint32_t x, uint32_t y, uint32_t z, int32_t stepX, int32_t stepY, int32_t stepZ);
+void perlin8Line(uint8_t *out, unsigned count, uint16_t x, uint16_t y, int stepX, int stepY);
+void perlin8Line(uint8_t *out, unsigned count, uint16_t x, uint16_t y, uint16_t z, int stepX, int stepY, int stepZ);
+void perlin8Tile(uint8_t *out, unsigned width, unsigned height, uint16_t x, uint16_t y, uint16_t z, int stepX, int stepY); // row by row
 
 // fast (true) random numbers using hardware RNG, all functions return values in the range lowerlimit to upperlimit-1
 // note: for true random numbers with high entropy, do not call faster than every 200ns (5MHz)
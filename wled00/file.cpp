@@ -32,6 +32,10 @@ static volatile size_t knownLargestSpace = MAX_SPACE;
 
 static File f; // don't export to other cpp files
 
+// position of the object written by the last writeObjectToFile() call: 0 if it was deleted, SIZE_MAX if unknown (used by the preset index)
+static size_t lastObjectPos = SIZE_MAX;
+static size_t lastFileSize = 0; // file size before the last writeObjectToFile() call
+
 //wrapper to find out how long closing takes
 void closeFile() {
   #ifdef WLED_DEBUG_FS
@@ -186,6 +190,7 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   if (!f) return false;
 
   if (f.size() < 3) {
+    lastObjectPos = SIZE_MAX; // file was reinitialized
     char init[10];
     strcpy_P(init, PSTR("{\"0\":{}}"));
     f.seek(0, SeekSet);           // rewind to ensure we overwrite from the start, instead of appending
@@ -193,6 +198,7 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   }
 
   if (content->isNull()) {
+    if (lastObjectPos != SIZE_MAX) lastObjectPos = 0;
     doCloseFile = true;
     return true; //nothing  to append
   }
@@ -203,6 +209,7 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   if (bufferedFindSpace(contentLen + strlen(key) + 1)) {
     if (f.position() > 2) f.write(','); //add comma if not first object
     f.print(key);
+    lastObjectPos = f.position();
     serializeJson(*content, f);
     DEBUGFS_PRINTF("Inserted, took %lu ms (total %lu)", millis() - s1, millis() - s);
     doCloseFile = true;
@@ -243,11 +250,13 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   } else { //file content is not valid JSON object
     f.seek(0, SeekSet);
     f.print('{'); //start JSON
+    lastObjectPos = SIZE_MAX;
   }
 
   f.print(key);
 
   //Append object
+  if (lastObjectPos != SIZE_MAX) lastObjectPos = f.position();
   serializeJson(*content, f);
   f.write('}');
 
@@ -256,11 +265,215 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   return true;
 }
 
+/*
+ * Preset index: position and length of each preset object in presets.json, so a preset can be read without scanning the file.
+ * writeObjectToFile() never moves existing objects (it replaces in place, writes into a hole or appends), so the index is
+ * updated on every write/delete of a preset. Deleted or shrunk presets leave spaces ("holes") behind which are removed by
+ * compactPresetsFile() once they make up a large part of the file.
+ * The index is rebuilt by a single pass over the file if presets.json was changed by other means (upload, /edit).
+ */
+struct PresetIndexEntry {
+  uint32_t offset; // position of the opening '{' of the preset object
+  uint16_t length; // length of the object (UINT16_MAX if longer, such a file is not compacted)
+  uint8_t  id;
+};
+static std::vector<PresetIndexEntry> presetIndex; // sorted by id
+static bool   presetIndexValid = false;
+static size_t presetIndexFileSize = 0;           // size of presets.json the index belongs to
+
+#ifdef WLED_DEBUG
+static uint32_t presetLookups = 0, presetLookupUs = 0, presetLookupMaxUs = 0;
+#endif
+
+static bool isPresetsFile(const char *file) {
+  char fileName[33]; strncpy_P(fileName, file, 32); fileName[32] = 0; //use PROGMEM safe copy
+  return strcmp_P(fileName, getPresetsFileName()) == 0;
+}
+
+static PresetIndexEntry *findPresetIndexEntry(uint8_t id) {
+  auto it = std::lower_bound(presetIndex.begin(), presetIndex.end(), id, [](const PresetIndexEntry &e, uint8_t i) { return e.id < i; });
+  return (it != presetIndex.end() && it->id == id) ? &*it : nullptr;
+}
+
+static void setPresetIndexEntry(uint8_t id, uint32_t offset, size_t length) {
+  PresetIndexEntry entry = {offset, uint16_t(length < UINT16_MAX ? length : UINT16_MAX), id};
+  auto it = std::lower_bound(presetIndex.begin(), presetIndex.end(), id, [](const PresetIndexEntry &e, uint8_t i) { return e.id < i; });
+  if (it != presetIndex.end() && it->id == id) *it = entry;
+  else presetIndex.insert(it, entry);
+}
+
+static void removePresetIndexEntry(uint8_t id) {
+  PresetIndexEntry *entry = findPresetIndexEntry(id);
+  if (entry) presetIndex.erase(presetIndex.begin() + (entry - presetIndex.data()));
+}
+
+// bytes of presets.json not used by preset objects, their keys and separators
+static size_t getPresetHoles() {
+  size_t used = 2; // root braces
+  for (const PresetIndexEntry &e : presetIndex) used += e.length + 5 + (e.id > 9) + (e.id > 99); // ,"N": + object
+  return presetIndexFileSize > used ? presetIndexFileSize - used : 0;
+}
+
+// single pass over the root object of presets.json, records the position of every object with a numeric key
+static bool buildPresetIndex(File &file) {
+  #ifdef WLED_DEBUG_FS
+    DEBUGFS_PRINTLN(F("Build preset index"));
+    uint32_t s = millis();
+  #endif
+  presetIndex.clear();
+  presetIndexValid = false;
+  if (!file) return false;
+
+  byte buf[FS_BUFSIZE];
+  unsigned depth = 0;
+  bool inString = false, escaped = false, expectKey = false, inKey = false, haveKey = false;
+  int key = -1, current = -1; // key being read (-1 if not numeric) and preset whose object is being read
+  size_t pos = 0, objStart = 0;
+  file.seek(0);
+  while (file.available() > 0) {
+    size_t bufsize = file.read(buf, FS_BUFSIZE);
+    if (bufsize == 0) break;
+    for (size_t i = 0; i < bufsize; i++, pos++) {
+      const char c = buf[i];
+      if (inString) {
+        if (escaped) escaped = false;
+        else if (c == '\\') escaped = true;
+        else if (c == '"') { inString = false; haveKey = inKey && key >= 0; inKey = false; }
+        else if (inKey) key = (c >= '0' && c <= '9' && key >= 0 && key < 256) ? key * 10 + (c - '0') : -1;
+        continue;
+      }
+      switch (c) {
+        case '"':
+          inString = true;
+          inKey = (depth == 1 && expectKey);
+          expectKey = false;
+          key = 0;
+          break;
+        case ':':
+          break;
+        case '{':
+          if (++depth == 2 && haveKey && key < 256 && !findPresetIndexEntry(key)) { current = key; objStart = pos; } // first one wins like bufferedFind()
+          expectKey = (depth == 1);
+          haveKey = false;
+          break;
+        case '}':
+          if (depth == 2 && current >= 0) { setPresetIndexEntry(current, objStart, pos - objStart + 1); current = -1; }
+          if (depth) depth--;
+          break;
+        case ',':
+          expectKey = (depth == 1);
+          haveKey = false;
+          break;
+        default:
+          if (depth == 1 && c != ' ' && c != '\n' && c != '\r' && c != '\t') haveKey = false; // non-object value
+          break;
+      }
+    }
+  }
+  presetIndexFileSize = file.size();
+  presetIndexValid = true;
+  DEBUGFS_PRINTF("Indexed %u presets, took %lu ms\n", (unsigned)presetIndex.size(), millis() - s);
+  return true;
+}
+
+// checks that the object at the indexed position is the preset's (i.e. is preceded by its key)
+// whitespace around ':' is skipped like in buildPresetIndex() so that pretty-printed files do not fail the check
+static bool checkPresetIndexEntry(File &file, const PresetIndexEntry &entry) {
+  char buf[32];
+  const size_t len = entry.offset < sizeof(buf) ? entry.offset : sizeof(buf);
+  file.seek(entry.offset - len);
+  if (file.read((uint8_t*)buf, len) != len) return false;
+  const auto isSpace = [](char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; };
+  size_t i = len; // walk back from the '{'
+  while (i > 0 && isSpace(buf[i-1])) i--;
+  if (i == 0 || buf[--i] != ':') return false;
+  while (i > 0 && isSpace(buf[i-1])) i--;
+  if (i == 0 || buf[--i] != '"') return false;
+  unsigned id = 0, scale = 1;
+  while (i > 0 && buf[i-1] >= '0' && buf[i-1] <= '9' && scale <= 1000) { id += (buf[--i] - '0') * scale; scale *= 10; }
+  return scale > 1 && i > 0 && buf[i-1] == '"' && id == entry.id;
+}
+
+static void abortPresetsCompaction();
+static volatile bool presetIndexStale = false; // set by invalidatePresetIndex(), applied by the holder of the JSON buffer lock
+static volatile uint8_t presetsGeneration = 0; // incremented by invalidatePresetIndex()
+
+static void resetPresetIndex() {
+  presetIndexStale = false;
+  abortPresetsCompaction();
+  presetIndexValid = false;
+  presetIndex.clear();
+}
+
+// may be called from async handlers (upload, /edit), the index and compaction files are only touched with the JSON buffer lock held
+// must be called before presets.json is changed: with the lock held, a compaction step cannot be replacing the file right now
+// and the compaction sees the new generation before it would replace the file later
+void invalidatePresetIndex() {
+  JSONBufferGuard lock(JSON_LOCK_PRESET_INVALID); // does not get the lock if this task holds it already
+  presetIndexStale = true;
+  presetsGeneration++;
+}
+
+// reads a preset from presets.json using the index, the index is (re)built if needed
+static bool readPresetUsingIndex(uint8_t id, JsonDocument* dest, const JsonDocument* filter) {
+  if (doCloseFile) closeFile();
+  if (presetIndexStale) resetPresetIndex();
+  #ifdef WLED_DEBUG
+  uint32_t s = micros();
+  #endif
+  f = WLED_FS.open(FPSTR(getPresetsFileName()), "r");
+  if (!f) return false;
+
+  if (!presetIndexValid || f.size() != presetIndexFileSize) buildPresetIndex(f);
+  PresetIndexEntry *entry = findPresetIndexEntry(id);
+  if (entry && !checkPresetIndexEntry(f, *entry)) {
+    DEBUGFS_PRINTLN(F("Preset index outdated"));
+    buildPresetIndex(f); // file changed without the size changing
+    entry = findPresetIndexEntry(id);
+  }
+  if (entry) f.seek(entry->offset);
+  #ifdef WLED_DEBUG
+  s = micros() - s;
+  presetLookups++;
+  presetLookupUs += s;
+  if (s > presetLookupMaxUs) presetLookupMaxUs = s;
+  #endif
+  if (!entry) {
+    f.close();
+    dest->clear();
+    DEBUGFS_PRINTLN(F("Obj not found."));
+    return false;
+  }
+
+  if (filter) deserializeJson(*dest, f, DeserializationOption::Filter(*filter));
+  else        deserializeJson(*dest, f);
+  f.close();
+  return true;
+}
+
+// applies the result of the last writeObjectToFile() for a preset to the index
+static void updatePresetIndex(uint8_t id, const JsonDocument* content) {
+  if (!presetIndexValid) return;
+  if (lastObjectPos == SIZE_MAX || !f || lastFileSize != presetIndexFileSize) {
+    resetPresetIndex(); // rebuilt on next read
+    return;
+  }
+  if (lastObjectPos) setPresetIndexEntry(id, lastObjectPos, measureJson(*content));
+  else               removePresetIndexEntry(id);
+  presetIndexFileSize = f.size();
+}
+
 bool writeObjectToFileUsingId(const char* file, uint16_t id, const JsonDocument* content)
 {
   char objKey[10];
   sprintf(objKey, "\"%d\":", id);
-  return writeObjectToFile(file, objKey, content);
+  if (id > 255 || !isPresetsFile(file)) return writeObjectToFile(file, objKey, content);
+
+  if (presetIndexStale) resetPresetIndex();
+  abortPresetsCompaction(); // copy would be outdated
+  bool success = writeObjectToFile(file, objKey, content);
+  updatePresetIndex(id, content);
+  return success;
 }
 
 bool writeObjectToFile(const char* file, const char* key, const JsonDocument* content)
@@ -274,6 +487,7 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
 
   if (doCloseFile) closeFile(); // This prevents the loss of file data that is still cached in the File object.
 
+  lastObjectPos = SIZE_MAX;
   size_t pos = 0;
   char fileName[129]; strncpy_P(fileName, file, 128); fileName[128] = 0; //use PROGMEM safe copy as FS.open() does not
   f = WLED_FS.open(fileName, WLED_FS.exists(fileName) ? "r+" : "w+");
@@ -281,9 +495,11 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
     DEBUGFS_PRINTLN(F("Failed to open!"));
     return false;
   }
+  lastFileSize = f.size();
 
   if (!bufferedFind(key)) //key does not exist in file
   {
+    lastObjectPos = 0;
     return appendObjectToFile(key, content, s);
   }
 
@@ -308,11 +524,13 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
   if (contentLen && contentLen <= oldLen) { //replace and fill diff with spaces
     DEBUGFS_PRINTLN(F("replace"));
     f.seek(pos);
+    lastObjectPos = pos;
     serializeJson(*content, f);
     writeSpace(pos2 - f.position());
   } else if (contentLen && bufferedFindSpace(contentLen - oldLen, false)) { //enough leading spaces to replace
     DEBUGFS_PRINTLN(F("replace (trailing)"));
     f.seek(pos);
+    lastObjectPos = pos;
     serializeJson(*content, f);
   } else {
     DEBUGFS_PRINTLN(F("delete"));
@@ -320,6 +538,7 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
     if (pos > 3) pos--; //also delete leading comma if not first object
     f.seek(pos);
     writeSpace(pos2 - pos);
+    lastObjectPos = 0;
     if (contentLen) return appendObjectToFile(key, content, s, contentLen);
   }
 
@@ -330,6 +549,7 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
 
 bool readObjectFromFileUsingId(const char* file, uint16_t id, JsonDocument* dest, const JsonDocument* filter)
 {
+  if (id <= 255 && isPresetsFile(file)) return readPresetUsingIndex(id, dest, filter);
   char objKey[10];
   sprintf(objKey, "\"%d\":", id);
   return readObjectFromFile(file, objKey, dest, filter);
@@ -363,6 +583,165 @@ bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, c
   return true;
 }
 
+
+/*
+ * Background compaction of presets.json: copies one preset per call into a new file without holes, which then replaces
+ * presets.json. Any change to presets.json while copying aborts it. Each step holds the JSON buffer lock, like every other
+ * access to presets.json and its index, so preset writes from async handlers cannot interleave with it.
+ * presets.json is never removed before the new file is in place: it is renamed to a backup first and restored from it
+ * by recoverPresetsFile() at boot if power is lost (or renaming fails) in between.
+ */
+#define PRESETS_COMPACT_MIN_HOLES 2048 // do not compact for less wasted bytes
+#define PRESETS_COMPACT_RATIO     4    // compact when holes are more than 1/4 of the file
+#define PRESETS_COMPACT_INTERVAL  10000 // ms between checks
+
+static const char presets_compact_tmp[] PROGMEM = "/pcompact.tmp";
+static const char presets_compact_bak[] PROGMEM = "/pcompact.bak";
+static File compactSrc, compactDst;
+static size_t compactNext = 0;                       // next index entry to copy
+static byte compactValidate = 0;                     // cacheInvalidate when compaction started (changes if a file was uploaded)
+static uint8_t compactGeneration = 0;                // presetsGeneration when compaction started (changes if presets.json is uploaded or deleted)
+static std::vector<PresetIndexEntry> compactedIndex; // index of the new file
+
+static void abortPresetsCompaction() {
+  if (!compactDst) return;
+  DEBUGFS_PRINTLN(F("Preset compaction aborted"));
+  compactSrc.close();
+  compactDst.close();
+  WLED_FS.remove(FPSTR(presets_compact_tmp));
+  compactedIndex.clear();
+  compactedIndex.shrink_to_fit();
+}
+
+// replaces presets.json with the compacted file, the old file is kept as backup until the new one is in place
+static bool replacePresetsFile() {
+  char fileName[33]; strncpy_P(fileName, getPresetsFileName(), 32);   fileName[32] = 0;
+  char tmpName[33];  strncpy_P(tmpName, presets_compact_tmp, 32);     tmpName[32] = 0;
+  char bakName[33];  strncpy_P(bakName, presets_compact_bak, 32);     bakName[32] = 0;
+  if (WLED_FS.rename(tmpName, fileName)) return true; // file systems that replace the target
+  WLED_FS.remove(bakName);
+  if (!WLED_FS.rename(fileName, bakName)) {
+    WLED_FS.remove(tmpName); // presets.json is untouched
+    return false;
+  }
+  if (WLED_FS.rename(tmpName, fileName)) {
+    WLED_FS.remove(bakName);
+    return true;
+  }
+  // keep both files, recoverPresetsFile() restores the backup if this fails too
+  if (WLED_FS.rename(bakName, fileName)) WLED_FS.remove(tmpName);
+  else errorFlag = ERR_FS_GENERAL;
+  return false;
+}
+
+static void compactPresetsStep() {
+  if (presetIndexStale) resetPresetIndex();
+  if (!compactDst) {
+    if (!presetIndexValid) return;
+    const size_t holes = getPresetHoles();
+    if (holes < PRESETS_COMPACT_MIN_HOLES || holes * PRESETS_COMPACT_RATIO < presetIndexFileSize) return;
+    for (const PresetIndexEntry &e : presetIndex) if (e.length == UINT16_MAX) return;
+    updateFSInfo();
+    if (presetIndexFileSize + 9000 > (fsBytesTotal - fsBytesUsed)) return; // same margin as appendObjectToFile()
+    compactSrc = WLED_FS.open(FPSTR(getPresetsFileName()), "r");
+    if (!compactSrc || compactSrc.size() != presetIndexFileSize) { compactSrc.close(); return; }
+    compactDst = WLED_FS.open(FPSTR(presets_compact_tmp), "w");
+    if (!compactDst) { compactSrc.close(); return; }
+    DEBUGFS_PRINTF("Compacting presets, %u of %u bytes unused\n", (unsigned)holes, (unsigned)presetIndexFileSize);
+    compactDst.print(F("{\"0\":{}")); // dummy object, see structural requirements
+    compactedIndex.clear();
+    compactedIndex.reserve(presetIndex.size());
+    compactedIndex.push_back({2 + 3, 2, 0});
+    compactNext = 0;
+    compactValidate = cacheInvalidate;
+    compactGeneration = presetsGeneration;
+    return;
+  }
+
+  if (compactValidate != cacheInvalidate || compactGeneration != presetsGeneration) { // presets.json may have been replaced
+    resetPresetIndex();
+    return;
+  }
+
+  if (compactNext < presetIndex.size()) {
+    const PresetIndexEntry &e = presetIndex[compactNext++];
+    if (e.id == 0) return; // already written
+    char objKey[10];
+    sprintf(objKey, ",\"%d\":", e.id);
+    compactDst.print(objKey);
+    const uint32_t offset = compactDst.position();
+    byte buf[FS_BUFSIZE];
+    compactSrc.seek(e.offset);
+    for (size_t left = e.length; left > 0; ) {
+      size_t block = left > FS_BUFSIZE ? FS_BUFSIZE : left;
+      if (compactSrc.read(buf, block) != block || compactDst.write(buf, block) != block) {
+        abortPresetsCompaction();
+        return;
+      }
+      left -= block;
+    }
+    compactedIndex.push_back({offset, e.length, e.id});
+    return;
+  }
+
+  compactDst.print('}');
+  const size_t newSize = compactDst.size();
+  compactSrc.close();
+  compactDst.close();
+  // an upload may have started since this step began (it invalidates with the lock, so it cannot slip in after this check)
+  if (presetIndexStale || compactGeneration != presetsGeneration || compactValidate != cacheInvalidate) {
+    WLED_FS.remove(FPSTR(presets_compact_tmp));
+    compactedIndex.clear();
+    resetPresetIndex();
+    return;
+  }
+  if (!replacePresetsFile()) {
+    DEBUGFS_PRINTLN(F("Preset compaction failed"));
+    compactedIndex.clear();
+    resetPresetIndex();
+    return;
+  }
+  DEBUGFS_PRINTF("Presets compacted to %u bytes\n", (unsigned)newSize);
+  presetIndex.swap(compactedIndex);
+  compactedIndex.clear();
+  compactedIndex.shrink_to_fit();
+  presetIndexFileSize = newSize;
+  updateFSInfo();
+}
+
+// called from loop when no preset is being applied or saved
+void compactPresetsFile() {
+  static unsigned long lastCheck = 0;
+  if (strip.isUpdating()) return; // accessing FS during sendout causes glitches
+  if (!compactDst) {
+    if (millis() - lastCheck < PRESETS_COMPACT_INTERVAL) return;
+    lastCheck = millis();
+  }
+  if (!requestJSONBufferLock(JSON_LOCK_PRESET_COMPACT)) return; // try again on next call
+  if (doCloseFile) closeFile();
+  compactPresetsStep();
+  releaseJSONBufferLock();
+}
+
+// restores presets.json if the device was reset (or renaming failed) while compactPresetsFile() replaced it, called at boot
+void recoverPresetsFile() {
+  char fileName[33]; strncpy_P(fileName, getPresetsFileName(), 32);   fileName[32] = 0;
+  char bakName[33];  strncpy_P(bakName, presets_compact_bak, 32);     bakName[32] = 0;
+  if (WLED_FS.exists(bakName)) {
+    if (WLED_FS.exists(fileName)) WLED_FS.remove(bakName); // new file was in place
+    else if (WLED_FS.rename(bakName, fileName)) DEBUGFS_PRINTLN(F("Presets restored from backup"));
+  }
+  WLED_FS.remove(FPSTR(presets_compact_tmp)); // incomplete or outdated copy
+}
+
+#ifdef WLED_DEBUG
+void printPresetIndexStats() {
+  DEBUG_PRINTF_P(PSTR("Preset lookups: %u, time[us]: %u/%u, index: %u presets, %u unused bytes\n"), presetLookups,
+    presetLookups ? presetLookupUs / presetLookups : 0, presetLookupMaxUs, (unsigned)presetIndex.size(), presetIndexValid ? (unsigned)getPresetHoles() : 0);
+  presetLookups = presetLookupUs = presetLookupMaxUs = 0;
+}
+#endif
+
 void updateFSInfo() {
   #ifdef ARDUINO_ARCH_ESP32
     #if WLED_FS == LITTLEFS || ESP_IDF_VERSION_MAJOR >= 4
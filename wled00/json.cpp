@@ -310,6 +310,7 @@ static bool deserializeSegment(JsonObject elem, byte it, byte presetId = 0)
   seg.check3 = getBoolVal(elem["o3"], seg.check3);
 
   getVal(elem["bm"], seg.blendMode);
+  getVal(elem["fps"], seg.fps);
 
   JsonArray iarr = elem[F("i")]; //set individual LEDs
   if (!iarr.isNull()) {
@@ -318,6 +319,7 @@ static bool deserializeSegment(JsonObject elem, byte it, byte presetId = 0)
     if (seg.isInTransition()) seg.startTransition(0); // setting transition time to 0 will stop transition in next frame
     strip.setTransition(0);
     strip.setBrightness(bri, true);
+    seg.unshareBuffers(); // pixels are written directly: copy-on-write of a buffer shared with a transition snapshot
 
     // freeze and init to black
     if (!seg.freeze) {
@@ -642,9 +644,11 @@ static void serializeSegment(JsonObject& root, const Segment& seg, byte id, bool
   root["si"]  = seg.soundSim;
   root["m12"] = seg.map1D2D;
   root["bm"]  = seg.blendMode;
+  root["fps"] = seg.fps;
 }
 
-void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segmentBounds, bool selectedSegmentsOnly)
+// state without segments
+static void serializeStateHeader(JsonObject root, bool forPreset, bool includeBri)
 {
   if (includeBri) {
     root["on"] = (bri > 0);
@@ -679,6 +683,11 @@ void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segme
   }
 
   root[F("mainseg")] = strip.getMainSegmentId();
+}
+
+void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segmentBounds, bool selectedSegmentsOnly)
+{
+  serializeStateHeader(root, forPreset, includeBri);
 
   JsonArray seg = root.createNestedArray("seg");
   for (size_t s = 0; s < WS2812FX::getMaxSegments(); s++) {
@@ -722,9 +731,19 @@ void serializeInfo(JsonObject root)
   JsonObject leds = root.createNestedObject(F("leds"));
   leds[F("count")] = strip.getLengthTotal();
   leds[F("pwr")] = BusManager::currentMilliamps();
+  leds[F("ppwr")] = BusManager::_useABL ? BusManager::predictedMilliamps() : 0; // current requested by the frame before ABL limiting
   leds["fps"] = strip.getFps();
+  JsonArray segFps = leds.createNestedArray(F("sfps")); // measured effect frame rate of each segment
+  for (size_t s = 0; s < strip.getSegmentsNum(); s++) segFps.add(strip.getSegment(s).getFps());
   leds[F("maxpwr")] = BusManager::currentMilliamps()>0 ? BusManager::ablMilliampsMax() : 0;
   leds[F("maxseg")] = WS2812FX::getMaxSegments();
+  leds[F("palmem")] = Segment::getPaletteCacheSize(); // decoded palettes kept for reuse
+  leds[F("falloc")] = strip.getFrameAllocations(); // buffer allocations by show(), should not grow while the setup does not change
+  JsonObject arena = leds.createNestedObject(F("arena")); // effect data arena
+  arena[F("size")] = Segment::getDataArenaSize();
+  arena[F("used")] = Segment::getUsedSegmentData();
+  arena[F("lfb")]  = Segment::getDataArenaLargestFree();     // largest free block
+  arena[F("frag")] = Segment::getDataArenaFragmentation();   // free space outside the largest free block in %
   //leds[F("actseg")] = strip.getActiveSegmentsNum();
   //leds[F("seglock")] = false; //might be used in the future to prevent modifications to segment config
   leds[F("bootps")] = bootPreset;
@@ -786,6 +805,11 @@ void serializeInfo(JsonObject root)
 
   root[F("lip")] = realtimeIP[0] == 0 ? "" : realtimeIP.toString();
 
+  JsonObject e131info = root.createNestedObject(F("e131")); // E1.31/Art-Net frame assembly
+  e131info[F("late")] = e131PacketsLate;
+  e131info[F("drop")] = e131FramesDropped;
+  e131info[F("part")] = e131FramesPartial;
+
   #ifdef WLED_ENABLE_WEBSOCKETS
   root[F("ws")] = ws.count();
   #else
@@ -842,6 +866,8 @@ void serializeInfo(JsonObject root)
   fs_info["t"] = fsBytesTotal / 1000;
   fs_info[F("pmt")] = presetsModifiedTime;
 
+  serializeJSONBufferStats(root.createNestedObject(F("jbuf")));
+
   root[F("ndc")] = nodeListEnabled ? (int)Nodes.size() : -1;
 
 #ifdef ARDUINO_ARCH_ESP32
@@ -1088,21 +1114,22 @@ void serializeNetworks(JsonObject root)
   }
 }
 
+static void serializeNode(JsonObject node, const NodeStruct &n)
+{
+  node[F("name")] = n.nodeName;
+  node["type"]    = n.nodeType;
+  node["ip"]      = n.ip.toString();
+  node[F("age")]  = n.age;
+  node[F("vid")]  = n.build;
+}
+
 void serializeNodes(JsonObject root)
 {
   JsonArray nodes = root.createNestedArray("nodes");
 
   for (NodesMap::iterator it = Nodes.begin(); it != Nodes.end(); ++it)
   {
-    if (it->second.ip[0] != 0)
-    {
-      JsonObject node = nodes.createNestedObject();
-      node[F("name")] = it->second.nodeName;
-      node["type"]    = it->second.nodeType;
-      node["ip"]      = it->second.ip.toString();
-      node[F("age")]  = it->second.age;
-      node[F("vid")]  = it->second.build;
-    }
+    if (it->second.ip[0] != 0) serializeNode(nodes.createNestedObject(), it->second);
   }
 }
 
@@ -1323,28 +1350,219 @@ void respondModeData(AsyncWebServerRequest* request) {
   });
 }
 
-// Global buffer locking response helper class (to make sure lock is released when AsyncJsonResponse is destroyed)
+// Generate a streamed JSON response for state, info, nodes or all of them (/json)
+// The response is serialized in parts (state without segments, each segment, info, each node, each effect name) into a
+// small JSON document which is reused for all parts and the text of each part is sent using sendChunked as it fits into
+// the outbound packet buffer. Neither the global JSON buffer nor a document for the whole response is needed, so any
+// number of clients can be served at the same time.
+// State, info and nodes are serialized by snapshot() when the request is received, with the JSON buffer lock held so
+// they cannot be changed by deserializeState() (presets, JSON API...) in between, and sent from that text. Only the
+// constant effect and palette names are serialized while sending.
+class JsonResponseStreamer {
+  public:
+    enum class Target : uint8_t { state, info, state_info, nodes, all };
+
+    JsonResponseStreamer(Target target);
+    bool snapshot();
+    size_t fill(uint8_t *data, size_t maxLen);
+
+  private:
+    enum Part : uint8_t { END, TEXT, STATE, SEGMENTS, INFO, NODES, EFFECTS, PALETTES };
+    struct Step { Part part; const char *text; }; // text (PROGMEM) is sent for TEXT parts
+
+    const Step *_step;          // part of the response being sent
+    unsigned    _index = 0;     // next segment, node or effect of the current part
+    unsigned    _count = 0;     // elements of the current part sent so far
+    DynamicJsonDocument _doc;
+    String      _text;          // text of the part being sent
+    const char *_flash;         // or PROGMEM text of the part being sent
+    size_t      _pos = 0, _len = 0;
+
+    bool nextPart();
+    template<typename Fn> void serializePart(Fn fn);
+};
+
+#define JSON_STREAM_PART_SIZE 1024 // initial size of the document for a part, grows if needed
+
+static const char stream_state_info[] PROGMEM = "{\"state\":";
+static const char stream_info[]       PROGMEM = ",\"info\":";
+static const char stream_effects[]    PROGMEM = ",\"effects\":[";
+static const char stream_palettes[]   PROGMEM = "],\"palettes\":";
+static const char stream_nodes[]      PROGMEM = "{\"nodes\":[";
+static const char stream_close[]      PROGMEM = "]}";
+static const char stream_end[]        PROGMEM = "}";
+
+JsonResponseStreamer::JsonResponseStreamer(Target target) : _doc(JSON_STREAM_PART_SIZE), _flash(nullptr)
+{
+  static const Step state[]      = { {STATE}, {SEGMENTS}, {TEXT, stream_close}, {END} };
+  static const Step info[]       = { {INFO}, {END} };
+  static const Step state_info[] = { {TEXT, stream_state_info}, {STATE}, {SEGMENTS}, {TEXT, stream_close}, {TEXT, stream_info}, {INFO}, {TEXT, stream_end}, {END} };
+  static const Step nodes[]      = { {TEXT, stream_nodes}, {NODES}, {TEXT, stream_close}, {END} };
+  static const Step all[]        = { {TEXT, stream_state_info}, {STATE}, {SEGMENTS}, {TEXT, stream_close}, {TEXT, stream_info}, {INFO},
+                                     {TEXT, stream_effects}, {EFFECTS}, {TEXT, stream_palettes}, {PALETTES}, {TEXT, stream_end}, {END} };
+  switch (target) {
+    case Target::state:      _step = state;      break;
+    case Target::info:       _step = info;       break;
+    case Target::state_info: _step = state_info; break;
+    case Target::nodes:      _step = nodes;      break;
+    default:                 _step = all;        break;
+  }
+}
+
+// serializes fn(JsonObject) into _text, the document is enlarged if it was too small
+template<typename Fn> void JsonResponseStreamer::serializePart(Fn fn)
+{
+  do {
+    _doc.clear();
+    fn(_doc.to<JsonObject>());
+    if (!_doc.overflowed() || _doc.capacity() >= JSON_BUFFER_SIZE) break;
+    const size_t size = _doc.capacity() * 2;
+    _doc = DynamicJsonDocument(size < JSON_BUFFER_SIZE ? size : JSON_BUFFER_SIZE);
+  } while (_doc.capacity() > 0);
+  _text = "";
+  serializeJson(_doc, _text);
+}
+
+// serializes all parts up to the effect names into _text, returns false if the JSON buffer lock is not available
+bool JsonResponseStreamer::snapshot()
+{
+  if (!requestJSONBufferLock(JSON_LOCK_SERVEJSON)) return false;
+  String text;
+  while (_step->part != END && _step->part != EFFECTS && _step->part != PALETTES && nextPart()) {
+    if (_flash) text += FPSTR(_flash);
+    else        text += _text;
+  }
+  releaseJSONBufferLock();
+  _text = std::move(text);
+  _flash = nullptr;
+  _pos = 0;
+  _len = _text.length();
+  return true;
+}
+
+// prepares the text of the next part, returns false when the response is complete
+bool JsonResponseStreamer::nextPart()
+{
+  _text = "";
+  _flash = nullptr;
+  while (_step->part != END) {
+    switch (_step->part) {
+      case TEXT:
+        _flash = _step->text;
+        break;
+      case STATE:
+        serializePart([](JsonObject root){ serializeStateHeader(root, false, true); });
+        if (_text.length() > 2 && _text[0] == '{') { // replace closing brace with segment array
+          _text.remove(_text.length() - 1);
+          _text += ',';
+        } else _text = "{";
+        _text += F("\"seg\":[");
+        break;
+      case SEGMENTS:
+        while (_index < strip.getSegmentsNum() && !strip.getSegment(_index).isActive()) _index++;
+        if (_index < strip.getSegmentsNum()) {
+          const unsigned id = _index++;
+          serializePart([id](JsonObject root){ serializeSegment(root, strip.getSegment(id), id, false, true); });
+          if (_count++) _text = String(',') + _text;
+          _pos = 0; _len = _text.length();
+          return true;
+        }
+        break;
+      case INFO:
+        serializePart([](JsonObject root){ serializeInfo(root); });
+        break;
+      case NODES: {
+        // look up the node following the last one serialized
+        auto it = _index < 256 ? Nodes.lower_bound(uint8_t(_index)) : Nodes.end();
+        while (it != Nodes.end() && it->second.ip[0] == 0) ++it;
+        if (it != Nodes.end()) {
+          _index = it->first + 1;
+          const NodeStruct &node = it->second;
+          serializePart([&node](JsonObject root){ serializeNode(root, node); });
+          if (_count++) _text = String(',') + _text;
+          _pos = 0; _len = _text.length();
+          return true;
+        }
+        break;
+      }
+      case EFFECTS:
+        while (_index < strip.getModeCount()) {
+          char lineBuffer[256];
+          strncpy_P(lineBuffer, strip.getModeData(_index++), sizeof(lineBuffer)-1);
+          lineBuffer[sizeof(lineBuffer)-1] = '\0';
+          if (lineBuffer[0] == 0) continue;
+          char *dataPtr = strchr(lineBuffer,'@');
+          if (dataPtr) *dataPtr = 0; // terminate mode data after name
+          char nameBuffer[2*sizeof(lineBuffer)+4]; // enough for every character escaped, quotes, comma and terminator
+          size_t len = writeJSONStringElement((uint8_t*)nameBuffer, sizeof(nameBuffer)-1, lineBuffer); // ,"name"
+          nameBuffer[len] = '\0';
+          _text = nameBuffer + (_count++ ? 0 : 1); // no comma before first name
+          _pos = 0; _len = _text.length();
+          return true;
+        }
+        break;
+      case PALETTES:
+        _flash = JSON_palette_names;
+        break;
+      default:
+        break;
+    }
+    _step++;
+    _index = _count = 0;
+    _pos = 0;
+    _len = _flash ? strlen_P(_flash) : _text.length();
+    if (_len) return true;
+  }
+  return false;
+}
+
+size_t JsonResponseStreamer::fill(uint8_t *data, size_t maxLen)
+{
+  size_t written = 0;
+  while (written < maxLen) {
+    if (_pos >= _len && !nextPart()) break;
+    size_t n = maxLen - written;
+    if (n > _len - _pos) n = _len - _pos;
+    if (_flash) memcpy_P(data + written, _flash + _pos, n);
+    else        memcpy(data + written, _text.c_str() + _pos, n);
+    _pos += n;
+    written += n;
+  }
+  return written;
+}
+
+static void serveStreamedJson(AsyncWebServerRequest* request, JsonResponseStreamer::Target target)
+{
+  auto streamer = std::make_shared<JsonResponseStreamer>(target); // freed with the response
+  if (!streamer->snapshot()) {
+    request->deferResponse();
+    return;
+  }
+  request->sendChunked(FPSTR(CONTENT_TYPE_JSON),
+    [streamer](uint8_t* data, size_t len, size_t) { return streamer->fill(data, len); });
+}
+
+// JSON buffer locking response helper class (to make sure the document is released when AsyncJsonResponse is destroyed)
 class LockedJsonResponse: public AsyncJsonResponse {
-  bool _holding_lock;
+  JsonDocument *_doc; // document obtained from requestJSONBuffer(), nullptr once released
   public:
-  // WARNING: constructor assumes requestJSONBufferLock() was successfully acquired externally/prior to constructing the instance
+  // WARNING: constructor assumes requestJSONBuffer() was successfully acquired externally/prior to constructing the instance
   // Not a good practice with C++. Unfortunately AsyncJsonResponse only has 2 constructors - for dynamic buffer or existing buffer,
   // with existing buffer it clears its content during construction
-  // if the lock was not acquired (using JSONBufferGuard class) previous implementation still cleared existing buffer
-  inline LockedJsonResponse(JsonDocument* doc, bool isArray) : AsyncJsonResponse(doc, isArray), _holding_lock(true) {};
+  inline LockedJsonResponse(JsonDocument* doc, bool isArray) : AsyncJsonResponse(doc, isArray), _doc(doc) {};
 
   virtual size_t _fillBuffer(uint8_t *buf, size_t maxLen) { 
     size_t result = AsyncJsonResponse::_fillBuffer(buf, maxLen);
     // Release lock as soon as we're done filling content
-    if (((result + _sentLength) >= (_contentLength)) && _holding_lock) {
-      releaseJSONBufferLock();
-      _holding_lock = false;
+    if (((result + _sentLength) >= (_contentLength)) && _doc) {
+      releaseJSONBuffer(_doc);
+      _doc = nullptr;
     }
     return result;
   }
 
-  // destructor will remove JSON buffer lock when response is destroyed in AsyncWebServer
-  virtual ~LockedJsonResponse() { if (_holding_lock) releaseJSONBufferLock(); };
+  // destructor will release the JSON document when response is destroyed in AsyncWebServer
+  virtual ~LockedJsonResponse() { releaseJSONBuffer(_doc); };
 };
 
 void serveJson(AsyncWebServerRequest* request)
@@ -1380,13 +1598,23 @@ void serveJson(AsyncWebServerRequest* request)
     return;
   }
 
-  if (!requestJSONBufferLock(JSON_LOCK_SERVEJSON)) {
+  switch (subJson) {
+    case json_target::state:      serveStreamedJson(request, JsonResponseStreamer::Target::state);      return;
+    case json_target::info:       serveStreamedJson(request, JsonResponseStreamer::Target::info);       return;
+    case json_target::state_info: serveStreamedJson(request, JsonResponseStreamer::Target::state_info); return;
+    case json_target::nodes:      serveStreamedJson(request, JsonResponseStreamer::Target::nodes);      return;
+    case json_target::all:        serveStreamedJson(request, JsonResponseStreamer::Target::all);        return;
+    default: break;
+  }
+
+  JsonDocument *doc = requestJSONBuffer(JSON_LOCK_SERVEJSON);
+  if (!doc) {
     request->deferResponse();    
     return;
   }
-  // releaseJSONBufferLock() will be called when "response" is destroyed (from AsyncWebServer)
+  // releaseJSONBuffer() will be called when "response" is destroyed (from AsyncWebServer)
   // make sure you delete "response" if no "request->send(response);" is made
-  LockedJsonResponse *response = new LockedJsonResponse(pDoc, subJson==json_target::effects); // will clear and convert JsonDocument into JsonArray if necessary
+  LockedJsonResponse *response = new LockedJsonResponse(doc, subJson==json_target::effects); // will clear and convert JsonDocument into JsonArray if necessary
 
   JsonVariant lDoc = response->getRoot();
 
@@ -1423,6 +1651,7 @@ void serveJson(AsyncWebServerRequest* request)
       //lDoc["m"] = lDoc.memoryUsage(); // JSON buffer usage, for remote debugging
   }
 
+  releaseJSONBufferState(doc); // response is sent from the document
   DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for request: %d\n"), lDoc.memoryUsage(), subJson);
 
   [[maybe_unused]] size_t len = response->setLength();
@@ -26,6 +26,78 @@ bool presetNeedsSaving() {
   return presetToSave;
 }
 
+/*
+ * Cache of presets pre-parsed into MessagePack, kept in RAM (PSRAM if available) and filled when a preset is applied the
+ * first time. A cached preset is applied without accessing the filesystem and MessagePack deserializes a lot faster than
+ * JSON text, which keeps preset and playlist switching time constant. Least recently used presets are evicted if full.
+ * The cache is only accessed with the JSON buffer lock held. Async handlers that change presets.json as a file (upload,
+ * /edit) increment cacheInvalidate instead, the cache is then dropped on the next lookup.
+ */
+struct PresetCacheEntry {
+  uint8_t *data;
+  size_t   size;
+  unsigned long lastUsed;
+  uint8_t  id;
+};
+static std::vector<PresetCacheEntry> presetCache;
+static size_t presetCacheUsed = 0;
+static byte presetCacheValidate = 0; // cacheInvalidate the cache belongs to (changes if a file was uploaded)
+
+static size_t getPresetCacheSize() {
+  #if defined(BOARD_HAS_PSRAM)
+  if (psramFound()) return PRESET_CACHE_PSRAM_SIZE;
+  #endif
+  return PRESET_CACHE_SIZE;
+}
+
+static void removePresetCacheEntry(size_t i) {
+  presetCacheUsed -= presetCache[i].size;
+  p_free(presetCache[i].data);
+  presetCache.erase(presetCache.begin() + i);
+}
+
+// drops the cached copy of a preset, or of all presets if index is 0
+static void invalidatePresetCache(byte index = 0) {
+  for (size_t i = presetCache.size(); i > 0; i--) {
+    if (index == 0 || presetCache[i-1].id == index) removePresetCacheEntry(i-1);
+  }
+  if (index == 0) {
+    presetCache.shrink_to_fit();
+    presetCacheValidate = cacheInvalidate;
+  }
+}
+
+// fills doc from the cache, returns false if the preset is not cached
+static bool readPresetFromCache(byte index, JsonDocument *doc) {
+  if (presetCacheValidate != cacheInvalidate) invalidatePresetCache(); // presets.json was uploaded or deleted
+  for (PresetCacheEntry &entry : presetCache) {
+    if (entry.id != index) continue;
+    if (deserializeMsgPack(*doc, (const uint8_t*)entry.data, entry.size)) return false;
+    entry.lastUsed = millis();
+    return true;
+  }
+  return false;
+}
+
+// stores the preset just read into doc in the cache
+static void addPresetToCache(byte index, const JsonDocument *doc) {
+  const size_t cacheSize = getPresetCacheSize();
+  const size_t size = measureMsgPack(*doc);
+  if (size == 0 || size > cacheSize / 2) return; // keep room for other presets
+  invalidatePresetCache(index);
+  while (presetCacheUsed + size > cacheSize) {
+    size_t oldest = 0;
+    for (size_t i = 1; i < presetCache.size(); i++) if (millis() - presetCache[i].lastUsed > millis() - presetCache[oldest].lastUsed) oldest = i;
+    removePresetCacheEntry(oldest);
+  }
+  uint8_t *data = static_cast<uint8_t*>(p_malloc(size));
+  if (!data) return;
+  serializeMsgPack(*doc, data, size);
+  presetCache.push_back({data, size, millis(), index});
+  presetCacheUsed += size;
+  DEBUG_PRINTF_P(PSTR("Preset %u cached (%u bytes, %u total)\n"), (unsigned)index, (unsigned)size, (unsigned)presetCacheUsed);
+}
+
 static void doSaveState() {
   bool persist = (presetToSave < 251);
 
@@ -70,7 +142,10 @@ static void doSaveState() {
   #endif
   writeObjectToFileUsingId(getPresetsFileName(persist), presetToSave, pDoc);
 
-  if (persist) presetsModifiedTime = toki.second(); //unix time
+  if (persist) {
+    invalidatePresetCache(presetToSave);
+    presetsModifiedTime = toki.second(); //unix time
+  }
   releaseJSONBufferLock();
   updateFSInfo();
 
@@ -152,7 +227,11 @@ void handlePresets()
     return;
   }
 
-  if (presetToApply == 0 || !requestJSONBufferLock(JSON_LOCK_PRESET_LOAD)) return; // no preset waiting to apply, or JSON buffer is already allocated, return to loop until free
+  if (presetToApply == 0) {
+    compactPresetsFile(); // nothing to do, remove holes left by deleted presets (if any)
+    return;
+  }
+  if (!requestJSONBufferLock(JSON_LOCK_PRESET_LOAD)) return; // JSON buffer is already allocated, return to loop until free
 
   bool changePreset = false;
   uint8_t tmpPreset = presetToApply; // store temporary since deserializeState() may call applyPreset()
@@ -165,18 +244,20 @@ void handlePresets()
 
   DEBUG_PRINTF_P(PSTR("Applying preset: %u\n"), (unsigned)tmpPreset);
 
-  #if defined(ARDUINO_ARCH_ESP32S2) || defined(ARDUINO_ARCH_ESP32C3)
-  unsigned long maxWait = millis() + strip.getFrameTime();
-  while (strip.isUpdating() && millis() < maxWait) delay(1); // wait for strip to finish updating, accessing FS during sendout causes glitches
-  #endif
-
   #ifdef ARDUINO_ARCH_ESP32
   if (tmpPreset==255 && tmpRAMbuffer!=nullptr) {
     deserializeJson(*pDoc,tmpRAMbuffer);
   } else
   #endif
-  {
+  if (tmpPreset < 255 && readPresetFromCache(tmpPreset, pDoc)) {
+    DEBUG_PRINTLN(F("Preset from cache"));
+  } else {
+  #if defined(ARDUINO_ARCH_ESP32S2) || defined(ARDUINO_ARCH_ESP32C3)
+  unsigned long maxWait = millis() + strip.getFrameTime();
+  while (strip.isUpdating() && millis() < maxWait) delay(1); // wait for strip to finish updating, accessing FS during sendout causes glitches
+  #endif
   presetErrFlag = readObjectFromFileUsingId(getPresetsFileName(tmpPreset < 255), tmpPreset, pDoc) ? ERR_NONE : ERR_FS_PLOAD;
+  if (presetErrFlag == ERR_NONE && tmpPreset < 255) addPresetToCache(tmpPreset, pDoc); // before fdo is modified below
   }
   fdo = pDoc->as<JsonObject>();
 
@@ -261,6 +342,7 @@ void savePreset(byte index, const char* pname, JsonObject sObj)
         if (sObj["n"].isNull()) sObj["n"] = saveName;
         initPresetsFile(); // just in case if someone deleted presets.json using /edit
         writeObjectToFileUsingId(getPresetsFileName(), index, pDoc);
+        invalidatePresetCache(index);
         presetsModifiedTime = toki.second(); //unix time
         updateFSInfo();
       }
@@ -280,6 +362,7 @@ void savePreset(byte index, const char* pname, JsonObject sObj)
 void deletePreset(byte index) {
   StaticJsonDocument<24> empty;
   writeObjectToFileUsingId(getPresetsFileName(), index, &empty);
+  invalidatePresetCache(index);
   presetsModifiedTime = toki.second(); //unix time
   updateFSInfo();
 }
\ No newline at end of file
@@ -223,6 +223,7 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
       char aw[4] = "AW"; aw[2] = offset+s; aw[3] = 0; //auto white mode
       char wo[4] = "WO"; wo[2] = offset+s; wo[3] = 0; //channel swap
       char sp[4] = "SP"; sp[2] = offset+s; sp[3] = 0; //bus clock speed (DotStar & PWM)
+      char un[4] = "UN"; un[2] = offset+s; un[3] = 0; //first universe or channel offset (network)
       char la[4] = "LA"; la[2] = offset+s; la[3] = 0; //LED mA
       char ma[4] = "MA"; ma[2] = offset+s; ma[3] = 0; //max mA
       char ld[4] = "LD"; ld[2] = offset+s; ld[3] = 0; //driver type (RMT=0, I2S=1)
@@ -265,6 +266,8 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
           case 3 : freq = 10000; break;
           case 4 : freq = 20000; break;
         }
+      } else if (Bus::isVirtual(type)) {
+        freq = request->arg(un).toInt(); // network buses keep their start universe/channel in the frequency field
       } else {
         freq = 0;
       }
@@ -475,6 +478,8 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     if (t > 0) e131Port = t;
     t = request->arg(F("EU")).toInt();
     if (t >= 0  && t <= 63999) e131Universe = t;
+    t = request->arg(F("EF")).toInt();
+    if (t >= 0  && t <= 1000) e131FrameTimeout = t;
     t = request->arg(F("DA")).toInt();
     if (t >= 0  && t <= 510) DMXAddress = t;
     t = request->arg(F("XX")).toInt();
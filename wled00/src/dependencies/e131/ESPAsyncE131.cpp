@@ -113,10 +113,13 @@ void ESPAsyncE131::parsePacket(AsyncUDPPacket _packet) {
   if (protocol == P_ARTNET) {
     if (memcmp(sbuff->art_id, ESPAsyncE131::ART_ID, sizeof(sbuff->art_id)))
       error = true; //not ART_ID = "Art-Net"
-    if (sbuff->art_opcode != ARTNET_OPCODE_OPDMX && sbuff->art_opcode != ARTNET_OPCODE_OPPOLL)
-      error = true; //not a DMX or poll packet
+    if (sbuff->art_opcode != ARTNET_OPCODE_OPDMX && sbuff->art_opcode != ARTNET_OPCODE_OPPOLL && sbuff->art_opcode != ARTNET_OPCODE_OPSYNC)
+      error = true; //not a DMX, poll or sync packet
   } else { //E1.31 error handling
-    if (pktLen < 126) { // need up to property_values[0] at offset 125
+    if (pktLen >= E131_SYNC_PACKET_LEN && htonl(sbuff->root_vector) == E131_VECTOR_ROOT_EXTENDED) {
+      if (htonl(sbuff->sync_vector) != E131_VECTOR_EXTENDED_SYNC)
+        error = true; //not a sync packet (universe discovery is not supported)
+    } else if (pktLen < 126) { // need up to property_values[0] at offset 125
       error = true;
     } else {
       if (htonl(sbuff->root_vector) != ESPAsyncE131::VECTOR_ROOT)
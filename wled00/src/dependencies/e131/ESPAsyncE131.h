@@ -77,6 +77,7 @@ typedef struct ip_addr ip4_addr_t;
 #define ARTNET_OPCODE_OPDMX 0x5000
 #define ARTNET_OPCODE_OPPOLL 0x2000
 #define ARTNET_OPCODE_OPPOLLREPLY 0x2100
+#define ARTNET_OPCODE_OPSYNC 0x5200
 
 #define P_E131   0
 #define P_ARTNET 1
@@ -107,6 +108,11 @@ typedef struct ip_addr ip4_addr_t;
 #define E131_DMP_COUNT 123
 #define E131_DMP_DATA 125
 
+// E1.31 universe synchronization packet (E1.31-2016: 6.3)
+#define E131_VECTOR_ROOT_EXTENDED 8
+#define E131_VECTOR_EXTENDED_SYNC 1
+#define E131_SYNC_PACKET_LEN 49
+
 // E1.31 Packet Structure
 typedef union {
     struct { //E1.31 packet
@@ -123,7 +129,7 @@ typedef union {
       uint32_t frame_vector;
       uint8_t  source_name[64];
       uint8_t  priority;
-      uint16_t reserved;
+      uint16_t sync_address; // E1.31-2016, 0 = unsynchronized
       uint8_t  sequence_number;
       uint8_t  options;
       uint16_t universe;
@@ -138,6 +144,15 @@ typedef union {
       uint8_t  property_values[513];
     } __attribute__((packed));
 	
+    struct { //E1.31 universe synchronization packet
+      uint8_t  sync_root[38]; // root layer, as above
+      uint16_t sync_flength;
+      uint32_t sync_vector;
+      uint8_t  sync_sequence_number;
+      uint16_t sync_universe;
+      uint16_t sync_reserved;
+    } __attribute__((packed));
+
 	struct { //Art-Net packet
     uint8_t  art_id[8];
     uint16_t art_opcode;
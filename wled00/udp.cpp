@@ -472,6 +472,7 @@ void handleNotifications()
     notify(notificationSentCallMode,true);
   }
 
+  handleE131FrameTimeout();
   if (e131NewData && millis() - strip.getLastShow() > 15)
   {
     e131NewData = false;
@@ -504,10 +505,7 @@ void handleNotifications()
       rgbUdp.read(lbuf, packetSize);
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_HYPERION);
       if (realtimeOverride) return;
-      unsigned totalLen = strip.getLengthTotal();
-      for (size_t i = 0, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++) {
-        setRealtimePixel(id, lbuf[i], lbuf[i+1], lbuf[i+2], 0);
-      }
+      setRealtimePixels(0, lbuf, min(size_t(packetSize / 3), size_t(strip.getLengthTotal())), 3);
       if (useMainSegmentOnly) strip.trigger();
       else                    strip.show();
       return;
@@ -587,9 +585,7 @@ void handleNotifications()
       unsigned totalLen = strip.getLengthTotal();
       // Clamp to prevent buffer overread: loop accesses up to udpIn[tpmPayloadFrameSize + 5]
       size_t currentPayloadFrameSize = (packetSize >= 5) ? min(tpmPayloadFrameSize, uint16_t(packetSize - 5)) : 0;
-      for (size_t i = 6; i < currentPayloadFrameSize + 4U && id < totalLen; i += 3, id++) {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-      }
+      if (id < totalLen) setRealtimePixels(id, udpIn + 6, min(currentPayloadFrameSize / 3, size_t(totalLen - id)), 3);
       if (tpmPacketCount == numPackets) { //reset packet count and show if all packets were received
         tpmPacketCount = 0;
         if (useMainSegmentOnly) strip.trigger();
@@ -618,24 +614,15 @@ void handleNotifications()
           setRealtimePixel(udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3], 0);
         }
       } else if (udpIn[0] == 2 && packetSize > 4) { //drgb
-        for (size_t i = 2, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++)
-          {
-            setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-          }
+        setRealtimePixels(0, udpIn + 2, min(size_t((packetSize - 2) / 3), size_t(totalLen)), 3);
       } else if (udpIn[0] == 3 && packetSize > 6) { //drgbw
-          for (size_t i = 2, id = 0; i < packetSize -3 && id < totalLen; i += 4, id++) {
-            setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-          }
+        setRealtimePixels(0, udpIn + 2, min(size_t((packetSize - 2) / 4), size_t(totalLen)), 4);
       } else if (udpIn[0] == 4 && packetSize > 7) { //dnrgb
         unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-        for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 3, id++) {
-          setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-        }
+        if (id < totalLen) setRealtimePixels(id, udpIn + 4, min(size_t((packetSize - 4) / 3), size_t(totalLen - id)), 3);
       } else if (udpIn[0] == 5 && packetSize > 8) { //dnrgbw
         unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-        for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 4, id++) {
-          setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-        }
+        if (id < totalLen) setRealtimePixels(id, udpIn + 4, min(size_t((packetSize - 4) / 4), size_t(totalLen - id)), 4);
       }
       if (useMainSegmentOnly) strip.trigger();
       else                    strip.show();
@@ -669,6 +656,19 @@ void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
   strip.setRealtimePixelColor(pix, RGBW32(r,g,b,w));
 }
 
+// bulk version of setRealtimePixel(), data holds count LEDs with 3 (RGB) or 4 (RGBW) bytes each
+void setRealtimePixels(unsigned start, const uint8_t *data, size_t count, unsigned channels)
+{
+  int pix = int(start) + arlsOffset;
+  if (pix < 0) { // negative offset: LEDs before strip start are dropped
+    if (size_t(-pix) >= count) return;
+    data  += size_t(-pix) * channels;
+    count -= size_t(-pix);
+    pix    = 0;
+  }
+  strip.setRealtimePixelColors(pix, data, count, channels);
+}
+
 /*********************************************************************************************\
    Refresh aging for remote units, drop if too old...
 \*********************************************************************************************/
@@ -736,7 +736,7 @@ void sendSysInfoUDP()
 
 
 /*********************************************************************************************\
- * Art-Net, DDP, E131 output - work in progress
+ * Art-Net, DDP, E131 output
 \*********************************************************************************************/
 
 //
@@ -747,140 +747,151 @@ void sendSysInfoUDP()
 // length - the number of pixels
 // buffer - a buffer of at least length*4 bytes long
 // isRGBW - true if the buffer contains 4 components per pixel
+// start  - first universe (E1.31, Art-Net) or data offset in bytes (DDP)
+//
+// every packet is assembled (header and scaled channel data) in one pre-allocated buffer and sent with a single write
 
 static       size_t sequenceNumber = 0; // this needs to be shared across all outputs
 static const size_t ART_NET_HEADER_SIZE = 12;
 static const byte   ART_NET_HEADER[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
+static const size_t E131_HEADER_SIZE = E131_DMP_DATA + 1; // including DMX start code
+static const byte   E131_ACN_ID[] PROGMEM = {0x41,0x53,0x43,0x2d,0x45,0x31,0x2e,0x31,0x37,0x00,0x00,0x00}; // "ASC-E1.17"
+static const size_t REALTIME_PACKET_SIZE = DDP_HEADER_LEN + DDP_CHANNELS_PER_PACKET; // largest of DDP, E1.31 and Art-Net
+
+static WiFiUDP  realtimeUdp;
+static uint8_t *realtimePacket = nullptr; // allocated on first use, only if there is a network bus
+
+// dst[i] = scale8(src[i], bri) for len bytes, 4 channels at a time
+static void scaleChannels(uint8_t *dst, const uint8_t *src, size_t len, uint8_t bri) {
+  if (bri == 255) { memcpy(dst, src, len); return; }
+  const uint32_t scale = 1U + bri; // same as scale8()
+  size_t i = 0;
+  for (; i + 4 <= len; i += 4) {
+    uint32_t w;
+    memcpy(&w, src + i, 4); // buffers need not be aligned
+    const uint32_t rb = (((w & 0x00FF00FF) * scale) >> 8) & 0x00FF00FF; // bytes 0 and 2, each product fits in 16 bits
+    const uint32_t ga = (((w >> 8) & 0x00FF00FF) * scale) & 0xFF00FF00; // bytes 1 and 3
+    w = rb | ga;
+    memcpy(dst + i, &w, 4);
+  }
+  for (; i < len; i++) dst[i] = scale8(src[i], bri);
+}
+
+static void prepareE131Header(uint8_t *p, size_t channels, uint16_t universe) {
+  const size_t len = E131_HEADER_SIZE + channels;
+  memset(p, 0, E131_HEADER_SIZE);
+  // root layer
+  p[1] = 0x10;                                          // preamble size
+  memcpy_P(p + 4, E131_ACN_ID, sizeof(E131_ACN_ID));
+  p[16] = 0x70 | ((len - 16) >> 8); p[17] = (len - 16) & 0xFF; // flags & length
+  p[21] = 0x04;                                         // VECTOR_ROOT_E131_DATA
+  const uint8_t *mac = (const uint8_t *)escapedMac.c_str();
+  for (size_t i = 0; i < 12 && i < escapedMac.length(); i++) p[22 + 4 + i] = mac[i]; // CID (16 bytes), unique per device
+  // framing layer
+  p[38] = 0x70 | ((len - 38) >> 8); p[39] = (len - 38) & 0xFF;
+  p[43] = 0x02;                                         // VECTOR_E131_DATA_PACKET
+  strncpy(reinterpret_cast<char*>(p + 44), serverDescription, 63); // source name
+  p[108] = 100;                                         // priority (default)
+  p[111] = sequenceNumber & 0xFF;
+  p[113] = universe >> 8; p[114] = universe & 0xFF;
+  // DMP layer
+  p[115] = 0x70 | ((len - 115) >> 8); p[116] = (len - 115) & 0xFF;
+  p[117] = 0x02;                                        // VECTOR_DMP_SET_PROPERTY
+  p[118] = 0xA1;                                        // address & data type
+  p[122] = 0x01;                                        // address increment
+  p[123] = (channels + 1) >> 8; p[124] = (channels + 1) & 0xFF; // property value count, including start code
+}
 
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t *buffer, uint8_t bri, bool isRGBW)  {
+uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t *buffer, uint8_t bri, bool isRGBW, uint16_t start)  {
   if (!(apActive || interfacesInited) || !client[0] || !length) return 1;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
 
-  WiFiUDP ddpUdp;
+  if (!realtimePacket) realtimePacket = static_cast<uint8_t*>(d_malloc(REALTIME_PACKET_SIZE));
+  if (!realtimePacket) return 1;
+  uint8_t *packet = realtimePacket;
 
+  const size_t channelCount = length * (isRGBW?4:3); // 1 channel for every R,G,B,(W?) value
+  size_t headerSize, channelsPerPacket;
+  uint16_t port;
   switch (type) {
     case 0: // DDP
-    {
-      // calculate the number of UDP packets we need to send
-      size_t channelCount = length * (isRGBW? 4:3); // 1 channel for every R,G,B value
-      size_t packetCount = ((channelCount-1) / DDP_CHANNELS_PER_PACKET) +1;
-
-      // there are 3 channels per RGB pixel
-      uint32_t channel = 0; // TODO: allow specifying the start channel
-      // the current position in the buffer
-      size_t bufferOffset = 0;
-
-      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
-        if (sequenceNumber > 15) sequenceNumber = 0;
+      headerSize = DDP_HEADER_LEN;
+      channelsPerPacket = DDP_CHANNELS_PER_PACKET;
+      port = DDP_DEFAULT_PORT; // port defined in ESPAsyncE131.h
+      break;
+    case 1: // E1.31
+      headerSize = E131_HEADER_SIZE;
+      channelsPerPacket = isRGBW?512:510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
+      port = E131_DEFAULT_PORT;
+      if (start == 0) start = 1; // universe 0 is reserved
+      sequenceNumber++;
+      break;
+    case 2: // ArtNet
+      headerSize = ART_NET_HEADER_SIZE + 6;
+      channelsPerPacket = isRGBW?512:510;
+      port = ARTNET_DEFAULT_PORT;
+      sequenceNumber++;
+      break;
+    default:
+      return 1;
+  }
+  const size_t packetCount = ((channelCount-1) / channelsPerPacket) +1;
 
-        if (!ddpUdp.beginPacket(client, DDP_DEFAULT_PORT)) {  // port defined in ESPAsyncE131.h
-          //DEBUG_PRINTLN(F("WiFiUDP.beginPacket returned an error"));
-          return 1; // problem
-        }
+  uint32_t channel = (type == 0) ? start : 0; // DDP data offset
+  const uint8_t *data = buffer;
 
-        // the amount of data is AFTER the header in the current packet
-        size_t packetSize = DDP_CHANNELS_PER_PACKET;
-
-        uint8_t flags = DDP_FLAGS_VER1;
-        if (currentPacket == (packetCount - 1U)) {
-          // last packet, set the push flag
-          // TODO: determine if we want to send an empty push packet to each destination after sending the pixel data
-          flags = DDP_FLAGS_VER1 | DDP_FLAGS_PUSH;
-          if (channelCount % DDP_CHANNELS_PER_PACKET) {
-            packetSize = channelCount % DDP_CHANNELS_PER_PACKET;
-          }
-        }
+  for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
+    // the amount of data is AFTER the header in the current packet
+    size_t packetSize = channelsPerPacket;
+    const bool lastPacket = (currentPacket == (packetCount - 1U));
+    if (lastPacket && (channelCount % channelsPerPacket)) packetSize = channelCount % channelsPerPacket;
 
-        // write the header
-        /*0*/ddpUdp.write(flags);
+    switch (type) {
+      case 0: // DDP
+        if (sequenceNumber > 15) sequenceNumber = 0;
+        // last packet sets the push flag
+        // TODO: determine if we want to send an empty push packet to each destination after sending the pixel data
+        packet[0] = lastPacket ? (DDP_FLAGS_VER1 | DDP_FLAGS_PUSH) : DDP_FLAGS_VER1;
         // TODO: sequence number should be 1-15 as 0 means "unused", it has no bad consequences other than out of sequence packet may be accepted
-        /*1*/ddpUdp.write(sequenceNumber++ & 0x0F); // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
-        /*2*/ddpUdp.write(isRGBW ?  DDP_TYPE_RGBW32 : DDP_TYPE_RGB24);
-        /*3*/ddpUdp.write(DDP_ID_DISPLAY);
+        packet[1] = sequenceNumber++ & 0x0F; // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
+        packet[2] = isRGBW ? DDP_TYPE_RGBW32 : DDP_TYPE_RGB24;
+        packet[3] = DDP_ID_DISPLAY;
         // data offset in bytes, 32-bit number, MSB first
-        /*4*/ddpUdp.write(0xFF & (channel >> 24));
-        /*5*/ddpUdp.write(0xFF & (channel >> 16));
-        /*6*/ddpUdp.write(0xFF & (channel >>  8));
-        /*7*/ddpUdp.write(0xFF & (channel      ));
+        packet[4] = 0xFF & (channel >> 24);
+        packet[5] = 0xFF & (channel >> 16);
+        packet[6] = 0xFF & (channel >>  8);
+        packet[7] = 0xFF & (channel      );
         // data length in bytes, 16-bit number, MSB first
-        /*8*/ddpUdp.write(0xFF & (packetSize >> 8));
-        /*9*/ddpUdp.write(0xFF & (packetSize     ));
-
-        // write the colors, the write write(const uint8_t *buffer, size_t size)
-        // function is just a loop internally too
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
-
-        if (!ddpUdp.endPacket()) {
-          //DEBUG_PRINTLN(F("WiFiUDP.endPacket returned an error"));
-          return 1; // problem
-        }
-
-        channel += packetSize;
-      }
-    } break;
-
-    case 1: //E1.31
-    {
-    } break;
-
-    case 2: //ArtNet
-    {
-      // calculate the number of UDP packets we need to send
-      const size_t channelCount = length * (isRGBW?4:3); // 1 channel for every R,G,B,(W?) value
-      const size_t ARTNET_CHANNELS_PER_PACKET = isRGBW?512:510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
-      const size_t packetCount = ((channelCount-1)/ARTNET_CHANNELS_PER_PACKET)+1;
-
-      uint32_t channel = 0; 
-      size_t bufferOffset = 0;
-
-      sequenceNumber++;
-
-      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
-
+        packet[8] = 0xFF & (packetSize >> 8);
+        packet[9] = 0xFF & (packetSize     );
+        break;
+      case 1: // E1.31, 1 full packet == 1 full universe
         if (sequenceNumber > 255) sequenceNumber = 0;
+        prepareE131Header(packet, packetSize, start + currentPacket);
+        break;
+      case 2: // ArtNet
+        if (sequenceNumber > 255) sequenceNumber = 0;
+        memcpy_P(packet, ART_NET_HEADER, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
+        packet[12] = sequenceNumber & 0xFF; // sequence number. 1..255
+        packet[13] = 0x00; // physical - more an FYI, not really used for anything. 0..3
+        packet[14] = (start + currentPacket) & 0xFF; // Universe LSB. 1 full packet == 1 full universe
+        packet[15] = ((start + currentPacket) >> 8) & 0x7F; // Universe MSB (net), 15 bit port address
+        packet[16] = 0xFF & (packetSize >> 8); // 16-bit length of channel data, MSB
+        packet[17] = 0xFF & (packetSize     ); // 16-bit length of channel data, LSB
+        break;
+    }
+    scaleChannels(packet + headerSize, data, packetSize, bri);
+    data += packetSize;
 
-        if (!ddpUdp.beginPacket(client, ARTNET_DEFAULT_PORT)) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.beginPacket returned an error"));
-          return 1; // borked
-        }
-
-        size_t packetSize = ARTNET_CHANNELS_PER_PACKET;
-
-        if (currentPacket == (packetCount - 1U)) {
-          // last packet
-          if (channelCount % ARTNET_CHANNELS_PER_PACKET) {
-            packetSize = channelCount % ARTNET_CHANNELS_PER_PACKET;
-          }
-        }
-
-        byte header_buffer[ART_NET_HEADER_SIZE];
-        memcpy_P(header_buffer, ART_NET_HEADER, ART_NET_HEADER_SIZE);
-        ddpUdp.write(header_buffer, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
-        ddpUdp.write(sequenceNumber & 0xFF); // sequence number. 1..255
-        ddpUdp.write(0x00); // physical - more an FYI, not really used for anything. 0..3
-        ddpUdp.write((currentPacket) & 0xFF); // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
-        ddpUdp.write(0x00); // Universe MSB, unused.
-        ddpUdp.write(0xFF & (packetSize >> 8)); // 16-bit length of channel data, MSB
-        ddpUdp.write(0xFF & (packetSize     )); // 16-bit length of channel data, LSB
-
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
-
-        if (!ddpUdp.endPacket()) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.endPacket returned an error"));
-          return 1; // borked
-        }
-        channel += packetSize;
-      }
-    } break;
+    if (!realtimeUdp.beginPacket(client, port)) {
+      DEBUG_PRINTLN(F("Realtime WiFiUDP.beginPacket returned an error"));
+      return 1; // problem
+    }
+    realtimeUdp.write(packet, headerSize + packetSize);
+    if (!realtimeUdp.endPacket()) {
+      DEBUG_PRINTLN(F("Realtime WiFiUDP.endPacket returned an error"));
+      return 1; // problem
+    }
+    channel += packetSize;
   }
   return 0;
 }
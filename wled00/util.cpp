@@ -2,6 +2,7 @@
 #include "fcn_declare.h"
 #include "const.h"
 #include "src/dependencies/fastled_slim/fastled_slim.h"
+#include <atomic>
 #ifdef ESP8266
 #include "user_interface.h" // for bootloop detection
 #include <Hash.h>            // for SHA1 on ESP8266
@@ -268,6 +269,37 @@ size_t utf8_strlen(const char *s)
 static SemaphoreHandle_t jsonBufferLockMutex = xSemaphoreCreateRecursiveMutex();
 #endif
 static volatile uint8_t jsonBufferLock = 0;
+#if JSON_POOL_SIZE > 0
+static SemaphoreHandle_t jsonPoolMutex = xSemaphoreCreateMutex();
+static PSRAMDynamicJsonDocument *jsonPool[JSON_POOL_SIZE] = {nullptr};
+static volatile uint8_t jsonPoolOwner[JSON_POOL_SIZE] = {0}; // module using the document, 0 if free
+static JsonDocument *jsonPoolStateDoc = nullptr; // pool document whose owner still holds the JSON buffer lock (state is being serialized)
+#endif
+// contention statistics (reported in /json/info)
+static uint16_t jsonLockFails = 0;     // global buffer requests that failed because it was locked
+static uint16_t jsonPoolFallbacks = 0; // pool requests served by the global buffer
+static uint16_t jsonLockMaxWait = 0;   // longest wait for the global buffer [ms]
+static uint16_t jsonLockYields = 0;    // web requests that gave way to a waiting preset/realtime request
+
+// acquisition priority: preset and realtime paths are not kept waiting behind web requests, while one of them waits
+// for the lock, web JSON requests (which are deferred and retried) and background compaction do not take it
+static std::atomic<uint8_t> jsonLockPriorityWaiters {0};
+
+static bool isPriorityJSONLock(uint8_t moduleID) {
+  switch (moduleID) {
+    case JSON_LOCK_PRESET_LOAD:
+    case JSON_LOCK_PRESET_SAVE:
+    case JSON_LOCK_NOTIFY:
+    case JSON_LOCK_REMOTE:
+    case JSON_LOCK_IR:
+      return true;
+  }
+  return false;
+}
+
+static bool isYieldingJSONLock(uint8_t moduleID) {
+  return moduleID == JSON_LOCK_SERVEJSON || moduleID == JSON_LOCK_PRESET_COMPACT;
+}
 
 //threading/network callback details: https://github.com/wled-dev/WLED/pull/2336#discussion_r762276994
 bool requestJSONBufferLock(uint8_t moduleID)
@@ -277,23 +309,47 @@ bool requestJSONBufferLock(uint8_t moduleID)
     return false;
   }
 
+  const bool priority = isPriorityJSONLock(moduleID);
+  const bool yielding = isYieldingJSONLock(moduleID);
+  if (yielding && jsonLockPriorityWaiters) {
+    jsonLockYields++;
+    return false;
+  }
+  if (priority) jsonLockPriorityWaiters++;
+
 #if defined(ARDUINO_ARCH_ESP32)
   // Use a recursive mutex type in case our task is the one holding the JSON buffer.
   // This can happen during large JSON web transactions.  In this case, we continue immediately
   // and then will return out below if the lock is still held.
-  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdFALSE) return false;  // timed out waiting
+  unsigned long now = millis();
+  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdFALSE) {  // timed out waiting
+    if (priority) jsonLockPriorityWaiters--;
+    jsonLockFails++;
+    jsonLockMaxWait = 250;
+    return false;
+  }
+  if (priority) jsonLockPriorityWaiters--;
+  if (millis() - now > jsonLockMaxWait) jsonLockMaxWait = millis() - now;
+  if (yielding && jsonLockPriorityWaiters) { // a preset/realtime request started waiting meanwhile
+    xSemaphoreGiveRecursive(jsonBufferLockMutex);
+    jsonLockYields++;
+    return false;
+  }
 #elif defined(ARDUINO_ARCH_ESP8266)
   // If we're in system context, delay() won't return control to the user context, so there's
   // no point in waiting.
   if (can_yield()) {
     unsigned long now = millis();
     while (jsonBufferLock && (millis()-now < 250)) delay(1); // wait for fraction for buffer lock
+    if (millis() - now > jsonLockMaxWait) jsonLockMaxWait = millis() - now;
   }
+  if (priority) jsonLockPriorityWaiters--;
 #else
   #error Unsupported task framework - fix requestJSONBufferLock
 #endif  
   // If the lock is still held - by us, or by another task
   if (jsonBufferLock) {
+    jsonLockFails++;
     DEBUG_PRINTF_P(PSTR("ERROR: Locking JSON buffer (%d) failed! (still locked by %d)\n"), moduleID, jsonBufferLock);
 #ifdef ARDUINO_ARCH_ESP32
     xSemaphoreGiveRecursive(jsonBufferLockMutex);
@@ -317,6 +373,89 @@ void releaseJSONBufferLock()
 #endif  
 }
 
+// Returns a cleared JSON document for serializing a response, or nullptr if none is available.
+// The JSON buffer lock is always taken: it keeps serializeState()/serializeInfo() away from deserializeState(), which
+// runs with the lock held (presets, JSON API, WS, UDP...) and may reallocate segments and their names.
+// If possible one of the pool documents is used for the output, so that the lock can be released with
+// releaseJSONBufferState() as soon as the state is serialized instead of being held until the response is sent.
+// The global buffer is only used (and stays locked) if the pool is exhausted.
+// The document must be released with releaseJSONBuffer(). Do not use it to deserialize state, deserializeState() may
+// rely on pDoc (e.g. when saving a preset).
+JsonDocument *requestJSONBuffer(uint8_t moduleID)
+{
+  if (!requestJSONBufferLock(moduleID)) return nullptr;
+#if JSON_POOL_SIZE > 0
+  if (!moduleID) moduleID = JSON_LOCK_UNKNOWN;
+  int slot = -1;
+  if (xSemaphoreTake(jsonPoolMutex, 10) == pdTRUE) {
+    for (int i = 0; i < JSON_POOL_SIZE && slot < 0; i++) if (!jsonPoolOwner[i]) slot = i;
+    if (slot >= 0) jsonPoolOwner[slot] = moduleID;
+    xSemaphoreGive(jsonPoolMutex);
+  }
+  if (slot >= 0) {
+    if (!jsonPool[slot] && psramFound()) {
+      jsonPool[slot] = new PSRAMDynamicJsonDocument(JSON_BUFFER_SIZE); // kept allocated
+      if (jsonPool[slot]->capacity() == 0) { // allocation failed
+        delete jsonPool[slot];
+        jsonPool[slot] = nullptr;
+      }
+    }
+    if (jsonPool[slot]) {
+      DEBUG_PRINTF_P(PSTR("JSON pool document %d locked. (%d)\n"), slot, moduleID);
+      jsonPool[slot]->clear();
+      jsonPoolStateDoc = jsonPool[slot];
+      return jsonPool[slot];
+    }
+    jsonPoolOwner[slot] = 0;
+  }
+  jsonPoolFallbacks++;
+#endif
+  return pDoc;
+}
+
+// to be called once the state has been serialized into a document from requestJSONBuffer(), releases the JSON buffer
+// lock unless the document is the global buffer
+void releaseJSONBufferState(JsonDocument *doc)
+{
+#if JSON_POOL_SIZE > 0
+  if (doc == nullptr || doc != jsonPoolStateDoc) return;
+  jsonPoolStateDoc = nullptr;
+  releaseJSONBufferLock();
+#endif
+}
+
+void releaseJSONBuffer(JsonDocument *doc)
+{
+  if (doc == nullptr) return;
+  if (doc == pDoc) {
+    releaseJSONBufferLock();
+    return;
+  }
+#if JSON_POOL_SIZE > 0
+  releaseJSONBufferState(doc); // if not done yet
+  for (int i = 0; i < JSON_POOL_SIZE; i++) {
+    if (jsonPool[i] != doc) continue;
+    DEBUG_PRINTF_P(PSTR("JSON pool document %d released. (%d)\n"), i, jsonPoolOwner[i]);
+    jsonPoolOwner[i] = 0;
+    return;
+  }
+#endif
+}
+
+void serializeJSONBufferStats(JsonObject root)
+{
+  unsigned inUse = 0;
+#if JSON_POOL_SIZE > 0
+  for (int i = 0; i < JSON_POOL_SIZE; i++) if (jsonPoolOwner[i]) inUse++;
+#endif
+  root[F("pool")]  = JSON_POOL_SIZE;
+  root[F("used")]  = inUse + (jsonBufferLock != 0);
+  root[F("fail")]  = jsonLockFails;
+  root[F("fallb")] = jsonPoolFallbacks;
+  root[F("wait")]  = jsonLockMaxWait;
+  root[F("yld")]   = jsonLockYields;
+}
+
 
 // extracts effect mode (or palette) name from names serialized string
 // caller must provide large enough buffer for name (including SR extensions)! maxLen is (buffersize - 1)
@@ -1147,21 +1286,40 @@ static inline __attribute__((always_inline)) int32_t gradient1D(uint32_t x0, int
   return (hashToGradient(h) * dx) >> PERLIN_SHIFT;
 }
 
-static inline __attribute__((always_inline)) int32_t gradient2D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy) {
+// hashed gradient of a lattice corner: components are -2..1, z is unused in 2D
+struct PerlinCorner { int32_t gx, gy, gz; };
+
+static inline __attribute__((always_inline)) PerlinCorner cornerGradient2D(uint32_t x0, uint32_t y0) {
   uint32_t h = (x0 * 0x27D4EB2D) ^ (y0 * 0xB5297A4D);
   h ^= h >> 15;
   h *= 0x92C3412B;
   h ^= h >> 13;
-  return (hashToGradient(h) * dx + hashToGradient(h>>PERLIN_SHIFT) * dy) >> (1 + PERLIN_SHIFT);
+  return {hashToGradient(h), hashToGradient(h>>PERLIN_SHIFT), 0};
 }
 
-static inline __attribute__((always_inline)) int32_t gradient3D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy, uint32_t z0, int32_t dz) {
+static inline __attribute__((always_inline)) PerlinCorner cornerGradient3D(uint32_t x0, uint32_t y0, uint32_t z0) {
   // fast and good entropy hash from corner coordinates
   uint32_t h = (x0 * 0x27D4EB2D) ^ (y0 * 0xB5297A4D) ^ (z0 * 0x1B56C4E9);
   h ^= h >> 15;
   h *= 0x92C3412B;
   h ^= h >> 13;
-  return ((hashToGradient(h) * dx + hashToGradient(h>>(1+PERLIN_SHIFT)) * dy + hashToGradient(h>>(1 + 2*PERLIN_SHIFT)) * dz) * 85) >> (8 + PERLIN_SHIFT); // scale to 16bit, x*85 >> 8 = x/3
+  return {hashToGradient(h), hashToGradient(h>>(1+PERLIN_SHIFT)), hashToGradient(h>>(1 + 2*PERLIN_SHIFT))};
+}
+
+static inline __attribute__((always_inline)) int32_t dotGradient2D(const PerlinCorner &c, int32_t dx, int32_t dy) {
+  return (c.gx * dx + c.gy * dy) >> (1 + PERLIN_SHIFT);
+}
+
+static inline __attribute__((always_inline)) int32_t dotGradient3D(const PerlinCorner &c, int32_t dx, int32_t dy, int32_t dz) {
+  return ((c.gx * dx + c.gy * dy + c.gz * dz) * 85) >> (8 + PERLIN_SHIFT); // scale to 16bit, x*85 >> 8 = x/3
+}
+
+static inline __attribute__((always_inline)) int32_t gradient2D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy) {
+  return dotGradient2D(cornerGradient2D(x0, y0), dx, dy);
+}
+
+static inline __attribute__((always_inline)) int32_t gradient3D(uint32_t x0, int32_t dx, uint32_t y0, int32_t dy, uint32_t z0, int32_t dz) {
+  return dotGradient3D(cornerGradient3D(x0, y0, z0), dx, dy, dz);
 }
 
 // fast cubic smoothstep: t*(3 - 2t²), optimized for fixed point, scaled to avoid overflows
@@ -1273,16 +1431,21 @@ int32_t perlin3D_raw(uint32_t x, uint32_t y, uint32_t z, bool is16bit) {
 }
 
 // scaling functions for fastled replacement
+static inline int32_t perlin16Scale2D(int32_t n) { return ((n * 1537) >> 10) + 32725; } //scale to 16bit and offset (fastled range: about 1748 to 63697)
+static inline int32_t perlin16Scale3D(int32_t n) { return ((n * 1731) >> 10) + 33147; } //scale to 16bit and offset (fastled range: about 4766 to 60840)
+static inline int32_t perlin8Scale2D(int32_t n)  { return (((n * 1620) >> 10) + 32771) >> 8; } //scale to 16 bit, offset, then scale to 8bit
+static inline int32_t perlin8Scale3D(int32_t n)  { return (((n * 2015) >> 10) + 33168) >> 8; } //scale to 16 bit, offset, then scale to 8bit
+
 uint16_t perlin16(uint32_t x) {
   return ((perlin1D_raw(x) * 1159) >> 10) + 32803; //scale to 16bit and offset (fastled range: about 4838 to 60766)
 }
 
 uint16_t perlin16(uint32_t x, uint32_t y) {
- return ((perlin2D_raw(x, y) * 1537) >> 10) + 32725; //scale to 16bit and offset (fastled range: about 1748 to 63697)
+  return perlin16Scale2D(perlin2D_raw(x, y));
 }
 
 uint16_t perlin16(uint32_t x, uint32_t y, uint32_t z) {
-  return ((perlin3D_raw(x, y, z) * 1731) >> 10) + 33147; //scale to 16bit and offset (fastled range: about 4766 to 60840)
+  return perlin16Scale3D(perlin3D_raw(x, y, z));
 }
 
 uint8_t perlin8(uint16_t x) {
@@ -1290,11 +1453,153 @@ uint8_t perlin8(uint16_t x) {
 }
 
 uint8_t perlin8(uint16_t x, uint16_t y) {
-  return (((perlin2D_raw((uint32_t)x << 8, (uint32_t)y << 8, true) * 1620) >> 10) + 32771) >> 8; //scale to 16 bit, offset, then scale to 8bit
+  return perlin8Scale2D(perlin2D_raw((uint32_t)x << 8, (uint32_t)y << 8, true));
 }
 
 uint8_t perlin8(uint16_t x, uint16_t y, uint16_t z) {
-  return (((perlin3D_raw((uint32_t)x << 8, (uint32_t)y << 8, (uint32_t)z << 8, true) * 2015) >> 10) + 33168) >> 8; //scale to 16 bit, offset, then scale to 8bit
+  return perlin8Scale3D(perlin3D_raw((uint32_t)x << 8, (uint32_t)y << 8, (uint32_t)z << 8, true));
+}
+
+/*
+ * Batch Perlin noise: fills out[i] with the value perlin8()/perlin16() returns at (x + i*stepX, y + i*stepY[, z + i*stepZ])
+ * Samples along a line mostly stay in the same lattice cell, so the corner gradients are only hashed when a new cell is
+ * entered (the shared corners are reused when moving one cell along x or y). Fade curves and the gradient dot product terms of
+ * axes that do not move along the line are only calculated once per cell.
+ * Coordinates wrap like the scalar functions (16 bit for perlin8(), 32 bit for perlin16()), results are identical.
+ */
+// 2D line, coordinates and steps are 16.16 fixed point, is16bit: coordinates wrap at 24 bits (a wrapping uint16_t << 8)
+template<typename T, int32_t (*scale)(int32_t)>
+static void perlin2DLine(T *out, unsigned count, uint32_t x, uint32_t y, uint32_t stepX, uint32_t stepY, bool is16bit) {
+  const uint32_t mask = is16bit ? 0x00FFFFFF : 0xFFFFFFFF;
+  PerlinCorner c00, c10, c01, c11; // corners (x0,y0), (x1,y0), (x0,y1), (x1,y1) of the current cell
+  int32_t cellX0 = -1, cellX1 = -1, cellY0 = -1, cellY1 = -1; // current cell, -1: none yet
+  uint32_t tx = smoothstep(x & 0xFFFF); // fade of an axis that does not move is calculated only once
+  uint32_t ty = smoothstep(y & 0xFFFF);
+  int32_t y00 = 0, y10 = 0, y01 = 0, y11 = 0; // y part of the gradient dot product of each corner (set with the first cell)
+  bool newCell = false;
+  for (unsigned i = 0; i < count; i++, x += stepX, y += stepY) {
+    const int32_t x0 = (x & mask) >> 16;
+    const int32_t y0 = (y & mask) >> 16;
+    if (x0 != cellX0 || y0 != cellY0) {
+      int32_t x1 = x0 + 1;
+      int32_t y1 = y0 + 1;
+      if (is16bit) {
+        x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
+        y1 = y1 & 0xFF;
+      }
+      if (y0 == cellY0 && x0 == cellX1) {        // next cell in x: left corners are the previous right ones
+        c00 = c10; c01 = c11;
+        c10 = cornerGradient2D(x1, y0); c11 = cornerGradient2D(x1, y1);
+      } else if (x0 == cellX0 && y0 == cellY1) { // next cell in y: upper corners are the previous lower ones
+        c00 = c01; c10 = c11;
+        c01 = cornerGradient2D(x0, y1); c11 = cornerGradient2D(x1, y1);
+      } else {
+        c00 = cornerGradient2D(x0, y0); c10 = cornerGradient2D(x1, y0);
+        c01 = cornerGradient2D(x0, y1); c11 = cornerGradient2D(x1, y1);
+      }
+      cellX0 = x0; cellX1 = x1; cellY0 = y0; cellY1 = y1;
+      newCell = true;
+    }
+    const int32_t dx0 = x & 0xFFFF;
+    const int32_t dx1 = dx0 - 0x10000;
+    if (newCell || stepY) { // y part of the gradient dot products only changes with the cell if moving along x
+      const int32_t dy0 = y & 0xFFFF;
+      const int32_t dy1 = dy0 - 0x10000;
+      y00 = c00.gy * dy0; y10 = c10.gy * dy0; y01 = c01.gy * dy1; y11 = c11.gy * dy1;
+      if (stepY) ty = smoothstep(dy0);
+      newCell = false;
+    }
+    if (stepX) tx = smoothstep(dx0);
+    // same as dotGradient2D()
+    const int32_t nx0 = lerpPerlin((c00.gx * dx0 + y00) >> (1 + PERLIN_SHIFT), (c10.gx * dx1 + y10) >> (1 + PERLIN_SHIFT), tx);
+    const int32_t nx1 = lerpPerlin((c01.gx * dx0 + y01) >> (1 + PERLIN_SHIFT), (c11.gx * dx1 + y11) >> (1 + PERLIN_SHIFT), tx);
+    out[i] = scale(lerpPerlin(nx0, nx1, ty));
+  }
+}
+
+// 3D line, see perlin2DLine()
+template<typename T, int32_t (*scale)(int32_t)>
+static void perlin3DLine(T *out, unsigned count, uint32_t x, uint32_t y, uint32_t z, uint32_t stepX, uint32_t stepY, uint32_t stepZ, bool is16bit) {
+  const uint32_t mask = is16bit ? 0x00FFFFFF : 0xFFFFFFFF;
+  PerlinCorner c[8]; // corners of the current cell, index bits: 0 = x1, 1 = y1, 2 = z1
+  int32_t cellX0 = -1, cellX1 = -1, cellY0 = -1, cellY1 = -1, cellZ0 = -1; // current cell, -1: none yet
+  uint32_t tx = smoothstep(x & 0xFFFF); // fade of an axis that does not move is calculated only once
+  uint32_t ty = smoothstep(y & 0xFFFF);
+  uint32_t tz = smoothstep(z & 0xFFFF);
+  int32_t yz[8];  // y and z part of the gradient dot product of each corner
+  bool newCell = false;
+  const bool fixedYZ = !stepY && !stepZ;
+  for (unsigned i = 0; i < count; i++, x += stepX, y += stepY, z += stepZ) {
+    const int32_t x0 = (x & mask) >> 16;
+    const int32_t y0 = (y & mask) >> 16;
+    const int32_t z0 = (z & mask) >> 16;
+    if (x0 != cellX0 || y0 != cellY0 || z0 != cellZ0) {
+      int32_t x1 = x0 + 1;
+      int32_t y1 = y0 + 1;
+      int32_t z1 = z0 + 1;
+      if (is16bit) {
+        x1 = x1 & 0xFF; // wrap back to zero at 0xFF instead of 0xFFFF
+        y1 = y1 & 0xFF;
+        z1 = z1 & 0xFF;
+      }
+      if (z0 == cellZ0 && y0 == cellY0 && x0 == cellX1) {        // next cell in x: reuse the previous x1 corners
+        for (unsigned k = 0; k < 8; k += 2) c[k] = c[k+1];
+        c[1] = cornerGradient3D(x1, y0, z0); c[3] = cornerGradient3D(x1, y1, z0);
+        c[5] = cornerGradient3D(x1, y0, z1); c[7] = cornerGradient3D(x1, y1, z1);
+      } else if (z0 == cellZ0 && x0 == cellX0 && y0 == cellY1) { // next cell in y: reuse the previous y1 corners
+        c[0] = c[2]; c[1] = c[3]; c[4] = c[6]; c[5] = c[7];
+        c[2] = cornerGradient3D(x0, y1, z0); c[3] = cornerGradient3D(x1, y1, z0);
+        c[6] = cornerGradient3D(x0, y1, z1); c[7] = cornerGradient3D(x1, y1, z1);
+      } else {
+        for (unsigned k = 0; k < 8; k++) c[k] = cornerGradient3D(k & 1 ? x1 : x0, k & 2 ? y1 : y0, k & 4 ? z1 : z0);
+      }
+      cellX0 = x0; cellX1 = x1; cellY0 = y0; cellY1 = y1; cellZ0 = z0;
+      newCell = true;
+    }
+    const int32_t dx0 = x & 0xFFFF;
+    const int32_t dx1 = dx0 - 0x10000;
+    if (newCell || !fixedYZ) { // y and z part of the gradient dot products only change with the cell if moving along x
+      const int32_t dy0 = y & 0xFFFF;
+      const int32_t dz0 = z & 0xFFFF;
+      const int32_t dy1 = dy0 - 0x10000;
+      const int32_t dz1 = dz0 - 0x10000;
+      for (unsigned k = 0; k < 8; k++) yz[k] = c[k].gy * (k & 2 ? dy1 : dy0) + c[k].gz * (k & 4 ? dz1 : dz0);
+      if (stepY) ty = smoothstep(dy0);
+      if (stepZ) tz = smoothstep(dz0);
+      newCell = false;
+    }
+    if (stepX) tx = smoothstep(dx0);
+    // same as dotGradient3D()
+    const auto grad = [&](unsigned k, int32_t dx) { return ((c[k].gx * dx + yz[k]) * 85) >> (8 + PERLIN_SHIFT); };
+    const int32_t nx0 = lerpPerlin(grad(0, dx0), grad(1, dx1), tx);
+    const int32_t nx1 = lerpPerlin(grad(2, dx0), grad(3, dx1), tx);
+    const int32_t nx2 = lerpPerlin(grad(4, dx0), grad(5, dx1), tx);
+    const int32_t nx3 = lerpPerlin(grad(6, dx0), grad(7, dx1), tx);
+    const int32_t ny0 = lerpPerlin(nx0, nx1, ty);
+    const int32_t ny1 = lerpPerlin(nx2, nx3, ty);
+    out[i] = scale(lerpPerlin(ny0, ny1, tz));
+  }
+}
+
+void perlin16Line(uint16_t *out, unsigned count, uint32_t x, uint32_t y, int32_t stepX, int32_t stepY) {
+  perlin2DLine<uint16_t, perlin16Scale2D>(out, count, x, y, stepX, stepY, false);
+}
+
+void perlin16Line(uint16_t *out, unsigned count, uint32_t x, uint32_t y, uint32_t z, int32_t stepX, int32_t stepY, int32_t stepZ) {
+  perlin3DLine<uint16_t, perlin16Scale3D>(out, count, x, y, z, stepX, stepY, stepZ, false);
+}
+
+void perlin8Line(uint8_t *out, unsigned count, uint16_t x, uint16_t y, int stepX, int stepY) {
+  perlin2DLine<uint8_t, perlin8Scale2D>(out, count, (uint32_t)x << 8, (uint32_t)y << 8, (uint32_t)stepX << 8, (uint32_t)stepY << 8, true);
+}
+
+void perlin8Line(uint8_t *out, unsigned count, uint16_t x, uint16_t y, uint16_t z, int stepX, int stepY, int stepZ) {
+  perlin3DLine<uint8_t, perlin8Scale3D>(out, count, (uint32_t)x << 8, (uint32_t)y << 8, (uint32_t)z << 8, (uint32_t)stepX << 8, (uint32_t)stepY << 8, (uint32_t)stepZ << 8, true);
+}
+
+// fills a width x height plane (row by row) with perlin8(x + i*stepX, y + j*stepY, z) for column i and row j
+void perlin8Tile(uint8_t *out, unsigned width, unsigned height, uint16_t x, uint16_t y, uint16_t z, int stepX, int stepY) {
+  for (unsigned j = 0; j < height; j++, y += stepY) perlin8Line(out + j*width, width, x, y, z, stepX, 0, 0);
 }
 
 #if !defined(ARDUINO_ARCH_ESP32) || (ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(6, 0, 0))    // ToDO: validate behaviour in V5
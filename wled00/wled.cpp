@@ -342,6 +342,7 @@ void WLED::loop()
       DEBUG_PRINTF_P(PSTR("UM time[ms]: %u/%lu\n"),   avgUsermodMillis/loops, maxUsermodMillis);
       DEBUG_PRINTF_P(PSTR("Strip time[ms]:%u/%lu\n"), avgStripMillis/loops,   maxStripMillis);
     }
+    printPresetIndexStats();
     strip.printSize();
     server.printStatus(DEBUGOUT);
     loops = 0;
@@ -487,6 +488,7 @@ void WLED::setup()
   }
 
   handleBootLoop(); // check for bootloop and take action (requires WLED_FS)
+  recoverPresetsFile(); // before initPresetsFile() would create an empty one
   initPresetsFile();
   updateFSInfo();
 
@@ -1127,6 +1129,7 @@ void WLED::handleStatusLED()
       #if STATUSLED>=0
       digitalWrite(STATUSLED, ledStatusState);
       #else
+      strip.waitForOutput(); // status pixel is written to the bus the output task may be sending
       BusManager::setStatusPixel(ledStatusState ? c : 0);
       #endif
     }
@@ -1138,6 +1141,7 @@ void WLED::handleStatusLED()
       digitalWrite(STATUSLED, LOW);
       #endif
     #else
+      strip.waitForOutput();
       BusManager::setStatusPixel(0);
     #endif
   }
@@ -473,6 +473,10 @@ WLED_GLOBAL uint16_t DMXSegmentSpacing _INIT(0);                  // Number of v
 WLED_GLOBAL byte e131LastSequenceNumber[E131_MAX_UNIVERSE_COUNT]; // to detect packet loss
 WLED_GLOBAL bool e131Multicast _INIT(false);                      // multicast or unicast
 WLED_GLOBAL bool e131SkipOutOfSequence _INIT(false);              // freeze instead of flickering
+WLED_GLOBAL uint16_t e131FrameTimeout _INIT(25);                  // ms to wait for missing universes or sync packet before a frame is shown (0 = show every universe)
+WLED_GLOBAL uint32_t e131PacketsLate _INIT(0);                    // universes received after a newer one (out of sequence)
+WLED_GLOBAL uint32_t e131FramesDropped _INIT(0);                  // frames overwritten by the next one before they were shown
+WLED_GLOBAL uint32_t e131FramesPartial _INIT(0);                  // frames shown with missing universes (sync or timeout)
 WLED_GLOBAL uint16_t pollReplyCount _INIT(0);                     // count number of replies for ArtPoll node report
 
 // mqtt
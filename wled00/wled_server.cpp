@@ -208,9 +208,12 @@ static void handleUpload(AsyncWebServerRequest *request, const String& filename,
       finalname = '/' + finalname; // prepend slash if missing
     }
 
+    if (finalname.equals(FPSTR(getPresetsFileName()))) {
+      presetsModifiedTime = toki.second();
+      invalidatePresetIndex(); // before the file is opened, so a running compaction cannot replace it
+    }
     request->_tempFile = WLED_FS.open(finalname, "w");
     DEBUG_PRINTF_P(PSTR("Uploading %s\n"), finalname.c_str());
-    if (finalname.equals(FPSTR(getPresetsFileName()))) presetsModifiedTime = toki.second();
   }
   if (len) {
     request->_tempFile.write(data,len);
@@ -311,10 +314,12 @@ static void createEditHandler() {
     }
 
     if (func == "delete") {
+      if (path.equals(FPSTR(getPresetsFileName()))) invalidatePresetIndex();
       if (!WLED_FS.remove(path))
         request->send(500, FPSTR(CONTENT_TYPE_PLAIN), F("Delete failed"));
       else
         request->send(200, FPSTR(CONTENT_TYPE_PLAIN), F("File deleted"));
+      cacheInvalidate++; // also drops the preset cache
       updateFSInfo(); // refresh memory usage info
       return;
     }
@@ -20,15 +20,227 @@ static unsigned long wsLastLiveTime = 0;
 
 #define WS_LIVE_INTERVAL 40
 
+/*
+ * Delta state push
+ * A client sends {"delta":true} to subscribe ({"delta":false} to unsubscribe). With the next broadcast it gets the
+ * full {"state":{},"info":{}} with an added version "dv", after that only the changes against the previous broadcast:
+ * {"delta":<version>,"state":{<changed keys>,"seg":[<changed segments>],"rmseg":[<removed segment ids>]},"info":{<changed keys>}}
+ * Keys that no longer exist are sent as null. A full state is pushed again every WS_DELTA_FULL_INTERVAL.
+ * A client that gets a version other than the previous one +1 missed a message and should subscribe again.
+ * Clients that did not subscribe get the full state with every broadcast as before.
+ * Broadcasts are coalesced by updateInterfaces() (at most one per INTERFACE_UPDATE_COOLDOWN).
+ */
+#define WS_MAX_TRACKED_CLIENTS 16
+
+enum : uint8_t {
+  WS_CLIENT_FULL = 0,   // full state with every broadcast
+  WS_CLIENT_DELTA,      // subscribed, changes only
+  WS_CLIENT_DELTA_SYNC  // subscribed, needs a full state with the next broadcast
+};
+
+typedef struct WsClientSlot {
+  uint32_t id;  // 0 = free slot
+  uint8_t  mode;
+} ws_client_slot_t;
+
+typedef struct WsDeltaKey {
+  String   name;
+  uint32_t hash;
+  bool     seen;
+  bool     changed;
+} ws_delta_key_t;
+
+static ws_client_slot_t wsClients[WS_MAX_TRACKED_CLIENTS] = {};
+static uint8_t wsUntrackedClients = 0;  // clients that did not get a slot, broadcasts fall back to the full state then
+static uint32_t wsDeltaVersion = 0;
+static unsigned long wsLastFullPush = 0;
+static std::vector<ws_delta_key_t> wsStateKeys;  // value hashes of the last broadcast, per top level key
+static std::vector<ws_delta_key_t> wsInfoKeys;
+static std::vector<uint32_t> wsSegHashes;        // value hashes of the last broadcast, per segment id (0 = no segment)
+
+// FNV-1a hash of the printed JSON
+class JsonHashPrint : public Print {
+  public:
+    uint32_t hash = 2166136261UL;
+    size_t write(uint8_t c) override { hash = (hash ^ c) * 16777619UL; return 1; }
+};
+
+// prints into a fixed size buffer, without buffer it only counts the bytes (to measure before allocating)
+class JsonBufferPrint : public Print {
+  public:
+    JsonBufferPrint(char *buf = nullptr, size_t size = 0) : _buf(buf), _size(size), _len(0) {}
+    size_t write(uint8_t c) override { if (_buf && _len < _size) _buf[_len] = c; _len++; return 1; }
+    size_t length() const { return _len; }
+  private:
+    char  *_buf;
+    size_t _size;
+    size_t _len;
+};
+
+static uint32_t hashJson(JsonVariantConst value) {
+  JsonHashPrint hasher;
+  serializeJson(value, hasher);
+  return hasher.hash | 1; // never 0, which marks an unused segment id
+}
+
+static ws_client_slot_t *getWsClientSlot(uint32_t id) {
+  for (auto &slot : wsClients) if (slot.id == id) return &slot;
+  return nullptr;
+}
+
+static void setWsClientMode(uint32_t id, uint8_t mode) {
+  ws_client_slot_t *slot = getWsClientSlot(id);
+  if (slot) slot->mode = mode;
+}
+
+static ws_delta_key_t *findDeltaKey(std::vector<ws_delta_key_t> &keys, const char *name, size_t hint) {
+  if (hint < keys.size() && keys[hint].name == name) return &keys[hint]; // keys usually come in the same order
+  for (auto &key : keys) if (key.name == name) return &key;
+  return nullptr;
+}
+
+// updates the value hashes in keys from the members of obj (except skip) and marks the ones that changed
+static void diffDeltaKeys(JsonObject obj, std::vector<ws_delta_key_t> &keys, const char *skip) {
+  for (auto &key : keys) key.seen = key.changed = false;
+  size_t i = 0;
+  for (JsonPair kv : obj) {
+    const char *name = kv.key().c_str();
+    if (skip && !strcmp(name, skip)) continue;
+    uint32_t hash = hashJson(kv.value());
+    ws_delta_key_t *key = findDeltaKey(keys, name, i++);
+    if (!key) {
+      keys.push_back({name, hash, true, true});
+    } else {
+      key->seen = true;
+      key->changed = key->hash != hash;
+      key->hash = hash;
+    }
+  }
+}
+
+static void printDeltaKey(Print &out, const char *name, bool &first) {
+  if (!first) out.write(',');
+  first = false;
+  out.write('"');
+  out.print(name);
+  out.print(F("\":"));
+}
+
+static void printDeltaKeys(Print &out, JsonObject obj, std::vector<ws_delta_key_t> &keys, const char *skip, bool &first) {
+  size_t i = 0;
+  for (JsonPair kv : obj) {
+    const char *name = kv.key().c_str();
+    if (skip && !strcmp(name, skip)) continue;
+    ws_delta_key_t *key = findDeltaKey(keys, name, i++);
+    if (!key || !key->changed) continue;
+    printDeltaKey(out, name, first);
+    serializeJson(kv.value(), out);
+  }
+  for (const auto &key : keys) {
+    if (key.seen) continue;
+    printDeltaKey(out, key.name.c_str(), first);
+    out.print(F("null"));
+  }
+}
+
+// prints the changes of the last diff (see prepareWsBroadcast()), segments are sent as a whole if anything in them changed
+static void printWsDelta(Print &out, JsonObject state, JsonObject info, const std::vector<uint32_t> &segHashes) {
+  out.print(F("{\"delta\":"));
+  out.print(wsDeltaVersion);
+  out.print(F(",\"state\":{"));
+  bool first = true;
+  printDeltaKeys(out, state, wsStateKeys, "seg", first);
+  bool any = false;
+  for (JsonObject seg : state["seg"].as<JsonArray>()) {
+    unsigned id = seg["id"];
+    if (id >= segHashes.size() || (id < wsSegHashes.size() && wsSegHashes[id] == segHashes[id])) continue;
+    if (!any) {
+      printDeltaKey(out, "seg", first);
+      out.write('[');
+    } else out.write(',');
+    serializeJson(seg, out);
+    any = true;
+  }
+  if (any) out.write(']');
+  any = false;
+  for (unsigned id = 0; id < wsSegHashes.size(); id++) {
+    if (!wsSegHashes[id] || (id < segHashes.size() && segHashes[id])) continue;
+    if (!any) {
+      printDeltaKey(out, "rmseg", first);
+      out.write('[');
+    } else out.write(',');
+    out.print(id);
+    any = true;
+  }
+  if (any) out.write(']');
+  out.print(F("},\"info\":{"));
+  first = true;
+  printDeltaKeys(out, info, wsInfoKeys, nullptr, first);
+  out.print(F("}}"));
+}
+
+// finds out which clients need the full state and which only the changes, if any client subscribed to deltas
+// the state is versioned and compared with the previous broadcast, returns true in that case
+static bool prepareWsBroadcast(JsonDocument &doc, JsonObject state, JsonObject info, std::vector<uint32_t> &segHashes, bool &needFull, bool &needDelta)
+{
+  if (millis() - wsLastFullPush > WS_DELTA_FULL_INTERVAL) {
+    // periodic full state, in case a client got out of sync without noticing
+    for (auto &slot : wsClients) if (slot.mode == WS_CLIENT_DELTA) slot.mode = WS_CLIENT_DELTA_SYNC;
+    wsLastFullPush = millis();
+  }
+  bool subscribed = false;
+  needFull = wsUntrackedClients > 0;
+  needDelta = false;
+  for (const auto &slot : wsClients) {
+    if (!slot.id) continue;
+    if (slot.mode == WS_CLIENT_DELTA) needDelta = true;
+    else                              needFull = true;
+    subscribed |= slot.mode != WS_CLIENT_FULL;
+  }
+  if (wsUntrackedClients) needDelta = false; // everyone gets the full state (which is versioned as well)
+  if (!subscribed) return false;
+
+  doc[F("dv")] = ++wsDeltaVersion;
+  diffDeltaKeys(state, wsStateKeys, "seg");
+  diffDeltaKeys(info, wsInfoKeys, nullptr);
+  segHashes.assign(wsSegHashes.size(), 0);
+  for (JsonObject seg : state["seg"].as<JsonArray>()) {
+    unsigned id = seg["id"];
+    if (id >= segHashes.size()) segHashes.resize(id+1, 0);
+    segHashes[id] = hashJson(seg);
+  }
+  return true;
+}
+
+// makes the diffed state the base for the next delta
+static void finishWsBroadcast(std::vector<uint32_t> &segHashes)
+{
+  for (auto *keys : {&wsStateKeys, &wsInfoKeys}) {
+    for (size_t i = 0; i < keys->size(); ) {
+      if ((*keys)[i].seen) i++;
+      else keys->erase(keys->begin() + i); // key no longer exists
+    }
+  }
+  wsSegHashes = std::move(segHashes);
+}
+
 void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len)
 {
   if(type == WS_EVT_CONNECT){
     //client connected
     DEBUG_PRINTLN(F("WS client connected."));
+    ws_client_slot_t *slot = getWsClientSlot(0);
+    if (slot) {
+      slot->mode = WS_CLIENT_FULL;
+      slot->id = client->id();
+    } else wsUntrackedClients++;
     sendDataWs(client);
   } else if(type == WS_EVT_DISCONNECT){
     //client disconnected
     if (client->id() == wsLiveClientId) wsLiveClientId = 0;
+    ws_client_slot_t *slot = getWsClientSlot(client->id());
+    if (slot) slot->id = 0;
+    else if (wsUntrackedClients) wsUntrackedClients--;
     DEBUG_PRINTLN(F("WS client disconnected."));
   } else if(type == WS_EVT_DATA){
     // data packet
@@ -61,6 +273,10 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
           verboseResponse = true;
         } else if (root.containsKey("lv")) {
           wsLiveClientId = root["lv"] ? client->id() : 0;
+        } else if (root.containsKey("delta")) {
+          bool subscribe = root["delta"];
+          setWsClientMode(client->id(), subscribe ? WS_CLIENT_DELTA_SYNC : WS_CLIENT_FULL);
+          if (subscribe && !interfaceUpdateCallMode) interfaceUpdateCallMode = CALL_MODE_WS_SEND; // full state with the next broadcast
         } else {
           verboseResponse = deserializeState(root);
         }
@@ -134,7 +350,8 @@ void sendDataWs(AsyncWebSocketClient * client)
 {
   if (!ws.count()) return;
 
-  if (!requestJSONBufferLock(JSON_LOCK_WS_SEND)) {
+  JsonDocument *doc = requestJSONBuffer(JSON_LOCK_WS_SEND);
+  if (!doc) {
     const char* error = PSTR("{\"error\":3}");
     if (client) {
       client->text(FPSTR(error)); // ERR_NOBUF
@@ -144,43 +361,69 @@ void sendDataWs(AsyncWebSocketClient * client)
     return;
   }
 
-  JsonObject state = pDoc->createNestedObject("state");
+  JsonObject state = doc->createNestedObject("state");
   serializeState(state);
-  JsonObject info  = pDoc->createNestedObject("info");
+  JsonObject info  = doc->createNestedObject("info");
   serializeInfo(info);
 
-  size_t len = measureJson(*pDoc);
-  DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for WS request (%u).\n"), pDoc->memoryUsage(), len);
+  bool needFull = true, needDelta = false, diffed = false;
+  std::vector<uint32_t> segHashes;
+  if (!client) diffed = prepareWsBroadcast(*doc, state, info, segHashes, needFull, needDelta);
+
+  size_t len = needFull ? measureJson(*doc) : 0;
+  JsonBufferPrint counter;
+  if (needDelta) printWsDelta(counter, state, info, segHashes);
+  size_t deltaLen = counter.length();
+  DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for WS request (%u, delta %u).\n"), doc->memoryUsage(), len, deltaLen);
 
   // the following may no longer be necessary as heap management has been fixed by @willmmiles in AWS
   size_t heap1 = getFreeHeapSize();
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
   AsyncWebSocketBuffer buffer(len);
+  AsyncWebSocketBuffer deltaBuffer(deltaLen);
   #ifdef ESP8266
   size_t heap2 = getFreeHeapSize();
   DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
   #else
   size_t heap2 = 0; // ESP32 variants do not have the same issue and will work without checking heap allocation
   #endif
-  if (!buffer || heap1-heap2<len) {
-    releaseJSONBufferLock();
+  if ((needFull && !buffer) || (needDelta && !deltaBuffer) || heap1-heap2<len+deltaLen) {
+    releaseJSONBuffer(doc);
     DEBUG_PRINTLN(F("WS buffer allocation failed."));
     ws.closeAll(1013); //code 1013 = temporary overload, try again later
     ws.cleanupClients(0); //disconnect all clients to release memory
     return; //out of memory
   }
-  serializeJson(*pDoc, (char *)buffer.data(), len);
+  if (needFull) serializeJson(*doc, (char *)buffer.data(), len);
+  if (needDelta) {
+    JsonBufferPrint out((char *)deltaBuffer.data(), deltaLen);
+    printWsDelta(out, state, info, segHashes);
+  }
+  if (diffed) finishWsBroadcast(segHashes);
+  releaseJSONBufferState(doc); // buffers are sent
 
   DEBUG_PRINT(F("Sending WS data "));
   if (client) {
     DEBUG_PRINTLN(F("to a single client."));
     client->text(std::move(buffer));
-  } else {
+  } else if (!needDelta) {
     DEBUG_PRINTLN(F("to multiple clients."));
     ws.textAll(std::move(buffer));
+  } else if (!needFull) {
+    DEBUG_PRINTLN(F("changes to multiple clients."));
+    ws.textAll(std::move(deltaBuffer));
+  } else {
+    DEBUG_PRINTLN(F("to each client."));
+    for (const auto &slot : wsClients) {
+      AsyncWebSocketClient *wsc = slot.id ? ws.client(slot.id) : nullptr;
+      if (!wsc) continue;
+      if (slot.mode == WS_CLIENT_DELTA) wsc->text((const char *)deltaBuffer.data(), deltaLen);
+      else                              wsc->text((const char *)buffer.data(), len);
+    }
   }
+  if (!client) for (auto &slot : wsClients) if (slot.mode == WS_CLIENT_DELTA_SYNC) slot.mode = WS_CLIENT_DELTA; // got the full state
 
-  releaseJSONBufferLock();
+  releaseJSONBuffer(doc);
 }
 
 static bool sendLiveLedsWs(uint32_t wsClient)